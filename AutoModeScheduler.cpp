@@ -0,0 +1,217 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "AutoModeScheduler.h"
+#include "DataModel/Loco.h"
+#include "Languages.h"
+#include "Logger/Logger.h"
+#include "Utils/Utils.h"
+
+using std::chrono::steady_clock;
+
+AutoModeScheduler::AutoModeScheduler(const unsigned int maxWorkers)
+:	logger(Logger::Logger::GetLogger("AutoMode")),
+	maxWorkers(std::max(maxWorkers, static_cast<unsigned int>(MinWorkers))),
+	idleWorkers(0),
+	run(true)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	for (unsigned int i = 0; i < MinWorkers; ++i)
+	{
+		workers.push_back(std::thread(&AutoModeScheduler::Worker, this));
+	}
+	logger->Info(Languages::TextAutoModeWorkers, static_cast<unsigned int>(MinWorkers), this->maxWorkers);
+}
+
+AutoModeScheduler::~AutoModeScheduler()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+		condition.notify_all();
+	}
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void AutoModeScheduler::WakeUp(DataModel::Loco* loco)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	Entry& entry = entries[loco];
+	if (entry.running)
+	{
+		// the worker steps the loco again when the running step has finished
+		entry.again = true;
+		return;
+	}
+	Schedule(loco, entry);
+}
+
+void AutoModeScheduler::Remove(DataModel::Loco* loco)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true)
+	{
+		auto entryIterator = entries.find(loco);
+		if (entryIterator == entries.end())
+		{
+			return;
+		}
+		Entry& entry = entryIterator->second;
+		if (entry.running)
+		{
+			idleCondition.wait(lock);
+			continue;
+		}
+		if (entry.timerSet)
+		{
+			timers.erase(entry.timer);
+		}
+		if (entry.scheduled)
+		{
+			ready.erase(std::remove(ready.begin(), ready.end(), loco), ready.end());
+		}
+		entries.erase(entryIterator);
+		return;
+	}
+}
+
+void AutoModeScheduler::Schedule(DataModel::Loco* loco, Entry& entry)
+{
+	if (entry.scheduled)
+	{
+		return;
+	}
+	entry.scheduled = true;
+	ready.push_back(loco);
+	if (idleWorkers == 0 && workers.size() < maxWorkers && run)
+	{
+		// all workers are stepping locos that may block, the ready loco must not wait for them
+		workers.push_back(std::thread(&AutoModeScheduler::Worker, this));
+		logger->Debug(Languages::TextAutoModeWorkerStarted, workers.size());
+		return;
+	}
+	condition.notify_one();
+}
+
+void AutoModeScheduler::LogDecisionTimes(DataModel::Loco* loco, Entry& entry)
+{
+	if (entry.steps == 0)
+	{
+		return;
+	}
+	logger->Info(Languages::TextAutoModeDecisionTimes,
+		loco->GetName(),
+		entry.steps,
+		entry.sumStepTime.count() / entry.steps,
+		entry.maxStepTime.count());
+	entry.steps = 0;
+	entry.sumStepTime = std::chrono::microseconds(0);
+	entry.maxStepTime = std::chrono::microseconds(0);
+}
+
+void AutoModeScheduler::Worker()
+{
+	Utils::Utils::SetMinThreadPriority();
+	Utils::Utils::SetThreadName("AutoMode");
+	std::unique_lock<std::mutex> lock(mutex);
+	while (run)
+	{
+		const steady_clock::time_point now = steady_clock::now();
+		while (timers.empty() == false && timers.begin()->first <= now)
+		{
+			DataModel::Loco* loco = timers.begin()->second;
+			timers.erase(timers.begin());
+			Entry& entry = entries[loco];
+			entry.timerSet = false;
+			Schedule(loco, entry);
+		}
+
+		if (ready.empty())
+		{
+			++idleWorkers;
+			if (timers.empty())
+			{
+				condition.wait(lock);
+			}
+			else
+			{
+				condition.wait_until(lock, timers.begin()->first);
+			}
+			--idleWorkers;
+			continue;
+		}
+
+		DataModel::Loco* loco = ready.front();
+		ready.pop_front();
+		{
+			Entry& entry = entries[loco];
+			entry.scheduled = false;
+			entry.running = true;
+			entry.again = false;
+			if (entry.timerSet)
+			{
+				timers.erase(entry.timer);
+				entry.timerSet = false;
+			}
+		}
+
+		lock.unlock();
+		const steady_clock::time_point start = steady_clock::now();
+		steady_clock::time_point nextCheck = start;
+		const bool active = loco->AutoModeStep(nextCheck);
+		const steady_clock::time_point end = steady_clock::now();
+		lock.lock();
+
+		// the entry can not have been removed while it was running
+		Entry& entry = entries[loco];
+		entry.running = false;
+		idleCondition.notify_all();
+		if (active == false)
+		{
+			LogDecisionTimes(loco, entry);
+			if (entry.again)
+			{
+				// the loco has been put into automode again while the last step has been running
+				Schedule(loco, entry);
+				continue;
+			}
+			entries.erase(loco);
+			continue;
+		}
+
+		const std::chrono::microseconds stepTime = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+		++entry.steps;
+		entry.sumStepTime += stepTime;
+		entry.maxStepTime = std::max(entry.maxStepTime, stepTime);
+
+		if (entry.again || nextCheck <= end)
+		{
+			Schedule(loco, entry);
+			continue;
+		}
+		entry.timer = timers.insert(std::make_pair(nextCheck, loco));
+		entry.timerSet = true;
+	}
+}
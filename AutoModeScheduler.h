@@ -0,0 +1,93 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace DataModel
+{
+	class Loco;
+}
+
+namespace Logger
+{
+	class Logger;
+}
+
+// The automode of all locos runs on a pool of worker threads. A loco in automode is a state
+// machine that is stepped whenever it got woken up (feedback reached, routes released, manual
+// mode requested) or its next check time has been reached. Ready locos are stepped in FIFO
+// order, so a busy loco can not starve the others.
+// A step may block: setting up a route sleeps the route delay per relation or waits for the
+// accessory pulses. So the pool is not sized by the number of cores, it grows whenever a loco
+// is ready and no worker is idle, up to maxWorkers.
+class AutoModeScheduler
+{
+	public:
+		AutoModeScheduler(const unsigned int maxWorkers);
+		~AutoModeScheduler();
+
+		// step the loco as soon as possible
+		void WakeUp(DataModel::Loco* loco);
+
+		// forget the loco, waits if it is stepped right now
+		void Remove(DataModel::Loco* loco);
+
+	private:
+		typedef std::multimap<std::chrono::steady_clock::time_point,DataModel::Loco*> Timers;
+
+		struct Entry
+		{
+			bool scheduled;
+			bool running;
+			bool again;
+			bool timerSet;
+			Timers::iterator timer;
+			uint64_t steps;
+			std::chrono::microseconds sumStepTime;
+			std::chrono::microseconds maxStepTime;
+		};
+
+		void Worker();
+		void Schedule(DataModel::Loco* loco, Entry& entry);
+		void LogDecisionTimes(DataModel::Loco* loco, Entry& entry);
+
+		static const unsigned int MinWorkers = 2;
+
+		Logger::Logger* logger;
+		const unsigned int maxWorkers;
+		unsigned int idleWorkers;
+		std::map<DataModel::Loco*,Entry> entries;
+		std::deque<DataModel::Loco*> ready;
+		Timers timers;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable idleCondition;
+		volatile bool run;
+		std::vector<std::thread> workers;
+};
@@ -0,0 +1,172 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "ControlDispatcher.h"
+#include "ControlInterface.h"
+#include "Languages.h"
+#include "Logger/Logger.h"
+#include "Utils/Utils.h"
+
+ControlDispatcher::ControlDispatcher(ControlInterface* control)
+:	control(control),
+	logger(Logger::Logger::GetLogger("Dispatcher " + control->GetName())),
+	busy(false),
+	busyKey(KeyNone),
+	run(true),
+	maxQueueDepth(0),
+	executed(0),
+	coalesced(0),
+	sumLatency(0),
+	maxLatency(0)
+{
+	workerThread = std::thread(&ControlDispatcher::Worker, this);
+}
+
+ControlDispatcher::~ControlDispatcher()
+{
+	{
+		std::lock_guard<std::mutex> guard(queueMutex);
+		run = false;
+		queueCondition.notify_all();
+	}
+	workerThread.join();
+	Statistics statistics = GetStatistics();
+	logger->Info(Languages::TextDispatcherStatistics,
+		statistics.executed,
+		statistics.maxQueueDepth,
+		statistics.coalesced,
+		statistics.averageLatency.count(),
+		statistics.maxLatency.count());
+}
+
+void ControlDispatcher::Dispatch(const Key key, const Task& task)
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	if (key != KeyNone)
+	{
+		// a waiting state update is stale, the new one replaces it at the end of the queue
+		for (auto entry = queue.begin(); entry != queue.end(); ++entry)
+		{
+			if (entry->key != key)
+			{
+				continue;
+			}
+			queue.erase(entry);
+			++coalesced;
+			break;
+		}
+	}
+	// no command gets lost, a stale state update is only removed when a newer one replaces it
+	if (queue.size() == MaxQueueDepth)
+	{
+		logger->Warning(Languages::TextDispatcherQueueFull, queue.size());
+	}
+	queue.push_back({ key, task, std::chrono::steady_clock::now() });
+	if (queue.size() > maxQueueDepth)
+	{
+		maxQueueDepth = queue.size();
+	}
+	queueCondition.notify_one();
+}
+
+void ControlDispatcher::WaitUntilDispatched()
+{
+	std::unique_lock<std::mutex> lock(queueMutex);
+	while (queue.empty() == false || busy)
+	{
+		idleCondition.wait(lock);
+	}
+}
+
+void ControlDispatcher::WaitUntilDispatched(const Key key)
+{
+	std::unique_lock<std::mutex> lock(queueMutex);
+	while (true)
+	{
+		bool waiting = (busy && busyKey == key);
+		for (auto& entry : queue)
+		{
+			if (entry.key == key)
+			{
+				waiting = true;
+				break;
+			}
+		}
+		if (waiting == false)
+		{
+			return;
+		}
+		idleCondition.wait(lock);
+	}
+}
+
+ControlDispatcher::Statistics ControlDispatcher::GetStatistics() const
+{
+	std::lock_guard<std::mutex> guard(queueMutex);
+	Statistics statistics;
+	statistics.queueDepth = queue.size();
+	statistics.maxQueueDepth = maxQueueDepth;
+	statistics.executed = executed;
+	statistics.coalesced = coalesced;
+	statistics.averageLatency = std::chrono::microseconds(executed == 0 ? 0 : sumLatency.count() / executed);
+	statistics.maxLatency = maxLatency;
+	return statistics;
+}
+
+void ControlDispatcher::Worker()
+{
+	Utils::Utils::SetThreadName("Dispatcher");
+	std::unique_lock<std::mutex> lock(queueMutex);
+	while (true)
+	{
+		if (queue.empty())
+		{
+			idleCondition.notify_all();
+			if (run == false)
+			{
+				return;
+			}
+			queueCondition.wait(lock);
+			continue;
+		}
+
+		Entry entry = queue.front();
+		queue.pop_front();
+		busy = true;
+		busyKey = entry.key;
+		lock.unlock();
+
+		entry.task(control);
+
+		const std::chrono::microseconds latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - entry.enqueued);
+		lock.lock();
+		busy = false;
+		if (entry.key != KeyNone)
+		{
+			idleCondition.notify_all();
+		}
+		++executed;
+		sumLatency += latency;
+		if (latency > maxLatency)
+		{
+			maxLatency = latency;
+		}
+	}
+}
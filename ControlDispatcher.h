@@ -0,0 +1,124 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "DataTypes.h"
+
+class ControlInterface;
+
+namespace Logger
+{
+	class Logger;
+}
+
+// Every control (webserver, hardware) gets its own dispatcher. The manager enqueues the
+// commands for a control here and returns immediately, the worker thread of the dispatcher
+// calls the control. So a slow control does not delay the other controls.
+class ControlDispatcher
+{
+	public:
+		typedef std::function<void(ControlInterface*)> Task;
+
+		// A waiting command is replaced by a new command with the same key.
+		// Commands with KeyNone are never replaced.
+		typedef uint64_t Key;
+		static const Key KeyNone = 0;
+
+		enum Command : uint8_t
+		{
+			CommandNone = 0,
+			CommandBooster,
+			CommandLocoSpeed,
+			CommandLocoOrientation,
+			CommandLocoFunction,
+			CommandAccessoryState,
+			CommandSwitchState,
+			CommandSignalState,
+			CommandFeedbackState,
+			CommandTrackState
+		};
+
+		static inline Key GetKey(const Command command, const ControlType controlType, const ObjectID objectID = ObjectNone, const uint32_t subID = 0)
+		{
+			return (static_cast<Key>(command) << 56)
+				| (static_cast<Key>(controlType) << 48)
+				| (static_cast<Key>(objectID) << 32)
+				| static_cast<Key>(subID);
+		}
+
+		struct Statistics
+		{
+			size_t queueDepth;
+			size_t maxQueueDepth;
+			uint64_t executed;
+			uint64_t coalesced;
+			std::chrono::microseconds averageLatency;
+			std::chrono::microseconds maxLatency;
+		};
+
+		ControlDispatcher() = delete;
+		ControlDispatcher(ControlInterface* control);
+		~ControlDispatcher();
+
+		void Dispatch(const Key key, const Task& task);
+		void WaitUntilDispatched();
+		// returns when no command with this key is waiting or running
+		void WaitUntilDispatched(const Key key);
+		Statistics GetStatistics() const;
+
+	private:
+		struct Entry
+		{
+			Key key;
+			Task task;
+			std::chrono::steady_clock::time_point enqueued;
+		};
+
+		void Worker();
+
+		// a longer queue is logged, it is not limited
+		static const size_t MaxQueueDepth = 1024;
+
+		ControlInterface* control;
+		Logger::Logger* logger;
+		std::deque<Entry> queue;
+		mutable std::mutex queueMutex;
+		std::condition_variable queueCondition;
+		std::condition_variable idleCondition;
+		bool busy;
+		Key busyKey;
+		volatile bool run;
+		std::thread workerThread;
+
+		size_t maxQueueDepth;
+		uint64_t executed;
+		uint64_t coalesced;
+		std::chrono::microseconds sumLatency;
+		std::chrono::microseconds maxLatency;
+};
@@ -119,6 +119,7 @@ class ControlInterface
 		virtual void ProgramRead(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv) {}
 		virtual void ProgramWrite(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
 		virtual void ProgramValue(__attribute__((unused)) const CvNumber cv, __attribute__((unused)) const CvValue value) {}
+		virtual void WaitUntilAccessoryPulseDone(__attribute__((unused)) const Protocol protocol, __attribute__((unused)) const Address address) {}
 
 	private:
 		ControlType controlType;
@@ -28,12 +28,13 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LayoutItem.h"
 #include "DataModel/LockableItem.h"
 #include "Languages.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
 namespace DataModel
 {
-	class Accessory : public AccessoryBase, public LayoutItem, public LockableItem
+	class Accessory : public AccessoryBase, public LayoutItem, public LockableItem, public Utils::PoolAllocated<Accessory>
 	{
 		public:
 			Accessory(const AccessoryID accessoryID)
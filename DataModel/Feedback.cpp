@@ -31,6 +31,8 @@ using std::to_string;
 
 namespace DataModel
 {
+	const std::chrono::milliseconds Feedback::DebounceTime(2250);
+
 	string Feedback::Serialize() const
 	{
 		string str;
@@ -38,7 +40,7 @@ namespace DataModel
 		str += ";controlID=" + to_string(controlID);
 		str += ";pin=" + to_string(pin);
 		str += ";inverted=" + to_string(inverted);
-		str += ";state=" + to_string(stateCounter > 0);
+		str += ";state=" + to_string(state);
 		str += ";" + relatedObject.Serialize();
 		return str;
 	}
@@ -59,35 +61,45 @@ namespace DataModel
 		controlID = Utils::Utils::GetIntegerMapEntry(arguments, "controlID", ControlIdNone);
 		pin = Utils::Utils::GetIntegerMapEntry(arguments, "pin");
 		inverted = Utils::Utils::GetBoolMapEntry(arguments, "inverted", false);
-		stateCounter = Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree) ? MaxStateCounter : 0;
+		state = static_cast<FeedbackState>(Utils::Utils::GetBoolMapEntry(arguments, "state", FeedbackStateFree));
 		relatedObject.Deserialize(arguments);
 		return true;
 	}
 
 	void Feedback::SetState(const FeedbackState newState)
 	{
-		FeedbackState state = static_cast<FeedbackState>(newState != inverted);
+		FeedbackState newStateInverted = static_cast<FeedbackState>(newState != inverted);
+		std::chrono::steady_clock::time_point deadline;
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (state == FeedbackStateFree)
+			if (newStateInverted == FeedbackStateFree)
 			{
-				if (stateCounter < MaxStateCounter)
+				if (state == FeedbackStateFree || falling)
 				{
 					return;
 				}
-				stateCounter = MaxStateCounter - 1;
-				return;
+				falling = true;
+				fallingDeadline = std::chrono::steady_clock::now() + DebounceTime;
+				deadline = fallingDeadline;
 			}
-
-			unsigned char oldStateCounter = stateCounter;
-			stateCounter = MaxStateCounter;
-
-			if (oldStateCounter > 0)
+			else
 			{
-				return;
+				falling = false;
+				if (state == FeedbackStateOccupied)
+				{
+					return;
+				}
+				state = FeedbackStateOccupied;
 			}
 		}
 
+		if (newStateInverted == FeedbackStateFree)
+		{
+			manager->FeedbackDebounceStart(GetID(), deadline);
+			return;
+		}
+
+		manager->LocoCalibrationFeedbackOccupied(GetID());
 		manager->FeedbackPublishState(this);
 		UpdateTrackState(FeedbackStateOccupied);
 	}
@@ -124,23 +136,23 @@ namespace DataModel
 		track->SetFeedbackState(GetID(), state);
 	}
 
-	void Feedback::Debounce()
+	bool Feedback::Debounce(const std::chrono::steady_clock::time_point now, std::chrono::microseconds& latency)
 	{
 		{
 			std::lock_guard<std::mutex> Guard(updateMutex);
-			if (stateCounter == MaxStateCounter || stateCounter == 0)
+			// the feedback got occupied again or a newer falling edge is pending
+			if (falling == false || now < fallingDeadline)
 			{
-				return;
+				return false;
 			}
 
-			--stateCounter;
-			if (stateCounter != 0)
-			{
-				return;
-			}
+			falling = false;
+			state = FeedbackStateFree;
+			latency = std::chrono::duration_cast<std::chrono::microseconds>(now - fallingDeadline);
 		}
 		manager->FeedbackPublishState(this);
 		UpdateTrackState(FeedbackStateFree);
+		return true;
 	}
 } // namespace DataModel
 
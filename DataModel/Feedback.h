@@ -20,6 +20,7 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
 #include <mutex>
 #include <string>
 
@@ -27,6 +28,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/ObjectIdentifier.h"
 #include "DataModel/LayoutItem.h"
 #include "Languages.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
@@ -34,7 +36,7 @@ namespace DataModel
 {
 	class TrackBase;
 
-	class Feedback : public LayoutItem
+	class Feedback : public LayoutItem, public Utils::PoolAllocated<Feedback>
 	{
 		public:
 			enum FeedbackState : bool
@@ -52,13 +54,15 @@ namespace DataModel
 			 	inverted(false),
 			 	relatedObject(),
 			 	track(nullptr),
-				stateCounter(0)
+				state(FeedbackStateFree),
+				falling(false)
 			{
 			}
 
 			inline Feedback(Manager* manager, const std::string& serialized)
 			:	manager(manager),
-				track(nullptr)
+				track(nullptr),
+				falling(false)
 			{
 				Deserialize(serialized);
 			}
@@ -91,10 +95,12 @@ namespace DataModel
 
 			inline FeedbackState GetState() const
 			{
-				return static_cast<FeedbackState>(stateCounter > 0);
+				return state;
 			}
 
-			void Debounce();
+			// releases the feedback if it has been free since the debounce time
+			// latency returns how late the release happened after the end of the debounce time
+			bool Debounce(const std::chrono::steady_clock::time_point now, std::chrono::microseconds& latency);
 
 			inline void SetControlID(const ControlID controlID)
 			{
@@ -160,8 +166,10 @@ namespace DataModel
 			bool inverted;
 			ObjectIdentifier relatedObject;
 			TrackBase* track;
-			unsigned char stateCounter;
-			static const unsigned char MaxStateCounter = 10;
+			FeedbackState state;
+			bool falling;
+			std::chrono::steady_clock::time_point fallingDeadline;
+			static const std::chrono::milliseconds DebounceTime;
 			mutable std::mutex updateMutex;
 	};
 
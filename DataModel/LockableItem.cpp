@@ -113,6 +113,16 @@ namespace DataModel
 		return true;
 	}
 
+	bool LockableItem::CanReserveAndLock(const LocoID locoID)
+	{
+		std::lock_guard<std::mutex> Guard(lockMutex);
+		if (this->locoID == locoID)
+		{
+			return lockState != LockStateSoftLocked;
+		}
+		return this->locoID == LocoNone && lockState == LockStateFree;
+	}
+
 	bool LockableItem::Release(__attribute__((unused)) Logger::Logger* logger, const LocoID locoID)
 	{
 		std::lock_guard<std::mutex> Guard(lockMutex);
@@ -65,6 +65,9 @@ namespace DataModel
 			virtual bool Lock(Logger::Logger* logger, const LocoID locoID);
 			virtual bool Release(Logger::Logger* logger, const LocoID locoID);
 
+			// checks if Reserve and Lock would succeed without changing anything
+			virtual bool CanReserveAndLock(const LocoID locoID);
+
 			inline bool IsInUse() const
 			{
 				return lockState != LockStateFree || locoID != LocoNone;
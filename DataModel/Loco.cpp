@@ -48,6 +48,7 @@ namespace DataModel
 			logger->Info(Languages::TextWaitingUntilHasStopped, name);
 			Utils::Utils::SleepForSeconds(1);
 		}
+		manager->LocoAutoModeRemove(this);
 		DeleteSlaves();
 	}
 
@@ -79,6 +80,26 @@ namespace DataModel
 		str += to_string(reducedSpeed);
 		str += ";creepingspeed=";
 		str += to_string(creepingSpeed);
+		str += ";accelerationtime=";
+		str += to_string(accelerationTime);
+		str += ";decelerationtime=";
+		str += to_string(decelerationTime);
+		str += ";calibrationstart=";
+		str += to_string(calibrationFeedbackStart);
+		str += ";calibrationend=";
+		str += to_string(calibrationFeedbackEnd);
+		str += ";calibrationdistance=";
+		str += to_string(calibrationDistance);
+		str += ";speedtable=";
+		string separator;
+		for (auto& entry : GetSpeedTable())
+		{
+			str += separator;
+			str += to_string(entry.first);
+			str += ":";
+			str += to_string(entry.second);
+			separator = ",";
+		}
 		return str;
 	}
 
@@ -113,6 +134,26 @@ namespace DataModel
 		reducedSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "reducedspeed", DefaultReducedSpeed);
 		creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepspeed", DefaultCreepingSpeed);
 		creepingSpeed = Utils::Utils::GetIntegerMapEntry(arguments, "creepingspeed", creepingSpeed);
+		accelerationTime = Utils::Utils::GetIntegerMapEntry(arguments, "accelerationtime", 0);
+		decelerationTime = Utils::Utils::GetIntegerMapEntry(arguments, "decelerationtime", 0);
+		calibrationFeedbackStart = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationstart", FeedbackNone);
+		calibrationFeedbackEnd = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationend", FeedbackNone);
+		calibrationDistance = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationdistance", 0);
+		std::deque<string> speedTableEntries;
+		Utils::Utils::SplitString(Utils::Utils::GetStringMapEntry(arguments, "speedtable"), ",", speedTableEntries);
+		SpeedTable table;
+		for (auto& speedTableEntry : speedTableEntries)
+		{
+			string step;
+			string realSpeed;
+			Utils::Utils::SplitString(speedTableEntry, ":", step, realSpeed);
+			if (realSpeed.size() == 0)
+			{
+				continue;
+			}
+			table[Utils::Utils::StringToInteger(step, MinSpeed, MaxSpeed)] = Utils::Utils::StringToInteger(realSpeed);
+		}
+		SetSpeedTable(table);
 		return true;
 	}
 
@@ -128,54 +169,54 @@ namespace DataModel
 		return true;
 	}
 
+	bool Loco::GetTrack(ObjectIdentifier& identifier, Orientation& trackOrientation) const
+	{
+		std::lock_guard<std::mutex> Guard(stateMutex);
+		if (trackFrom == nullptr)
+		{
+			return false;
+		}
+		identifier = trackFrom->GetObjectIdentifier();
+		trackOrientation = trackFrom->GetLocoOrientation();
+		return true;
+	}
+
 	bool Loco::Release()
 	{
-		manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+		manager->LocoStopImmediately(ControlTypeInternal, this);
 		ForceManualMode();
 		std::lock_guard<std::mutex> Guard(stateMutex);
 
-		if (routeFirst != nullptr)
+		for (auto& block : blocks)
 		{
-			routeFirst->Release(logger, objectID);
-			routeFirst = nullptr;
-		}
-		if (routeSecond != nullptr)
-		{
-			routeSecond->Release(logger, objectID);
-			routeSecond = nullptr;
+			block.route->Release(logger, objectID);
 		}
 		if (trackFrom != nullptr)
 		{
 			trackFrom->BaseRelease(logger, objectID);
 			trackFrom = nullptr;
 		}
-		if (trackFirst != nullptr)
-		{
-			trackFirst->BaseRelease(logger, objectID);
-			trackFirst = nullptr;
-		}
-		if (trackSecond != nullptr)
+		for (auto& block : blocks)
 		{
-			trackSecond->BaseRelease(logger, objectID);
-			trackSecond = nullptr;
+			block.track->BaseRelease(logger, objectID);
 		}
+		blocks.clear();
 		feedbackIdOver = FeedbackNone;
 		feedbackIdStop = FeedbackNone;
 		feedbackIdCreep = FeedbackNone;
 		feedbackIdReduced = FeedbackNone;
-		feedbackIdFirst = FeedbackNone;
 		return true;
 	}
 
 	bool Loco::IsRunningFromTrack(const TrackID trackID) const
 	{
 		std::lock_guard<std::mutex> Guard(stateMutex);
-		return trackFirst != nullptr && trackFrom != nullptr && trackFrom->GetMyID() == trackID;
+		return blocks.empty() == false && trackFrom != nullptr && trackFrom->GetMyID() == trackID;
 	}
 
 	bool Loco::GoToAutoMode()
 	{
-		std::lock_guard<std::mutex> Guard(stateMutex);
+		std::unique_lock<std::mutex> lock(stateMutex);
 		if (trackFrom == nullptr)
 		{
 			logger->Warning(Languages::TextCanNotStartNotOnTrack, name);
@@ -188,7 +229,6 @@ namespace DataModel
 		}
 		if (state == LocoStateTerminated)
 		{
-			locoThread.join();
 			state = LocoStateManual;
 		}
 		if (state != LocoStateManual)
@@ -198,8 +238,13 @@ namespace DataModel
 		}
 
 		state = LocoStateSearchingFirst;
-		locoThread = std::thread(&DataModel::Loco::AutoMode, this);
-
+		autoModeStarted = std::chrono::steady_clock::now();
+		blocksPassed = 0;
+		stops = 0;
+		stopsAvoided = 0;
+		logger->Info(Languages::TextIsNowInAutoMode, name);
+		lock.unlock();
+		WakeUpAutoMode();
 		return true;
 	}
 
@@ -210,6 +255,12 @@ namespace DataModel
 			return;
 		}
 		requestManualMode = true;
+		WakeUpAutoMode();
+	}
+
+	void Loco::WakeUpAutoMode()
+	{
+		manager->LocoAutoModeWakeUp(this);
 	}
 
 	bool Loco::GoToManualMode()
@@ -218,11 +269,11 @@ namespace DataModel
 		{
 			return true;
 		}
+		std::lock_guard<std::mutex> Guard(stateMutex);
 		if (state != LocoStateTerminated)
 		{
 			return false;
 		}
-		locoThread.join();
 		state = LocoStateManual;
 		return true;
 	}
@@ -244,121 +295,155 @@ namespace DataModel
 					break;
 			}
 		}
-		locoThread.join();
+		WakeUpAutoMode();
+		std::unique_lock<std::mutex> lock(stateMutex);
+		while (state != LocoStateTerminated && state != LocoStateManual)
+		{
+			stateCondition.wait(lock);
+		}
 		state = LocoStateManual;
 	}
 
-	void Loco::AutoMode()
+	bool Loco::AutoModeStep(std::chrono::steady_clock::time_point& nextCheck)
 	{
-		Utils::Utils::SetMinThreadPriority();
-		const string& name = GetName();
-		Utils::Utils::SetThreadName(name);
-		logger->Info(Languages::TextIsNowInAutoMode, name);
-
-		while (true)
+		nextCheck = std::chrono::steady_clock::now() + manager->GetAutoModeIdleRecheck();
+		bool routesReleased = false;
+		bool stateChanged = false;
 		{
-			{ // sleep must be outside of locked block
-				std::lock_guard<std::mutex> Guard(stateMutex);
-				if (feedbackIdsReached.IsEmpty() == false)
+			std::lock_guard<std::mutex> Guard(stateMutex);
+			if (state == LocoStateManual || state == LocoStateTerminated)
+			{
+				// stale wake up, the loco is not in automode
+				return false;
+			}
+			const LocoState stateBefore = state;
+			while (feedbackIdsReached.IsEmpty() == false)
+			{
+				FeedbackReached feedbackReached = feedbackIdsReached.Dequeue();
+				const FeedbackID feedbackId = feedbackReached.feedbackID;
+				routesReleased |= FeedbackReachedInternal(feedbackId, feedbackReached.reached);
+				logger->Debug(Languages::TextFeedbackHandledAfter, manager->GetFeedbackName(feedbackId), std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - feedbackReached.reached).count());
+			}
+
+			if (brakePlanned)
+			{
+				if (std::chrono::steady_clock::now() >= brakeAt)
 				{
-					FeedbackID feedbackId = feedbackIdsReached.Dequeue();
-					if (feedbackId == feedbackIdFirst)
+					brakePlanned = false;
+					if (speed > creepingSpeed)
 					{
-						FeedbackIdFirstReached();
-					}
-					if (feedbackId == feedbackIdStop)
-					{
-						if (feedbackIdFirst != FeedbackNone)
-						{
-							FeedbackIdFirstReached();
-						}
-						FeedbackIdStopReached();
+						manager->LocoSpeed(ControlTypeInternal, this, creepingSpeed);
 					}
 				}
+				else
+				{
+					nextCheck = std::min(nextCheck, brakeAt);
+				}
+			}
 
-				switch (state)
+			switch (state)
+			{
+				case LocoStateOff:
+					// automode is turned off, leave scheduler
+					logger->Info(Languages::TextIsNowInManualMode, name);
+					LogBlockStatistics();
+					manager->LocoWaitsFor(objectID, vector<vector<LocoID>>());
+					state = LocoStateTerminated;
+					requestManualMode = false;
+					stateCondition.notify_all();
+					return false;
+
+				case LocoStateSearchingFirst:
 				{
-					case LocoStateOff:
-						// automode is turned off, terminate thread
-						logger->Info(Languages::TextIsNowInManualMode, name);
-						state = LocoStateTerminated;
-						requestManualMode = false;
-						return;
-
-					case LocoStateSearchingFirst:
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-							break;
-						}
-						if (wait > 0)
-						{
-							--wait;
-							break;
-						}
-						SearchDestinationFirst();
+					if (requestManualMode)
+					{
+						state = LocoStateOff;
 						break;
-
-					case LocoStateSearchingSecond:
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-							break;
-						}
-						if (manager->GetNrOfTracksToReserve() <= 1)
-						{
-							break;
-						}
-						if (wait > 0)
-						{
-							break;
-						}
-						SearchDestinationSecond();
+					}
+					const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+					if (wait > 0)
+					{
+						waitUntil = now + std::chrono::seconds(wait);
+						wait = 0;
+					}
+					if (now < waitUntil)
+					{
+						nextCheck = std::min(nextCheck, waitUntil);
 						break;
+					}
+					SearchDestinationFirst();
+					break;
+				}
 
-					case LocoStateRunning:
-						// loco is already running, waiting until destination reached
-						if (requestManualMode)
-						{
-							logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
-							state = LocoStateStopping;
-						}
+				case LocoStateSearchingNext:
+					if (requestManualMode)
+					{
+						logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+						state = LocoStateStopping;
 						break;
-
-					case LocoStateStopping:
-						logger->Info(Languages::TextHasNotReachedDestination, name);
-
+					}
+					if (wait > 0)
+					{
 						break;
-
-					case LocoStateTerminated:
-						logger->Error(Languages::TextIsInTerminatedState, name);
-						state = LocoStateError;
+					}
+					if (blocks.size() >= manager->GetNrOfTracksToReserve() && PreReservationDue(nextCheck) == false)
+					{
 						break;
+					}
+					SearchDestinationNext();
+					break;
 
-					case LocoStateManual:
-						logger->Error(Languages::TextIsInManualState, name);
-						state = LocoStateError;
-						#include "Fallthrough.h"
-
-					case LocoStateError:
-						logger->Error(Languages::TextIsInErrorState, name);
-						manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
-						if (requestManualMode)
-						{
-							state = LocoStateOff;
-						}
+				case LocoStateRunning:
+					// loco is already running, waiting until destination reached
+					if (requestManualMode)
+					{
+						logger->Info(Languages::TextIsRunningWaitingUntilDestination, name);
+						state = LocoStateStopping;
 						break;
-				}
+					}
+					if (wait == 0 && PreReservationDue(nextCheck))
+					{
+						SearchDestinationNext();
+					}
+					break;
+
+				case LocoStateStopping:
+					logger->Info(Languages::TextHasNotReachedDestination, name);
+					break;
+
+				case LocoStateManual:
+				case LocoStateTerminated:
+					// already handled above
+					break;
+
+				case LocoStateError:
+					logger->Error(Languages::TextIsInErrorState, name);
+					manager->LocoStopImmediately(ControlTypeInternal, this);
+					if (requestManualMode)
+					{
+						state = LocoStateOff;
+					}
+					break;
 			}
-			// FIXME: make configurable
-			Utils::Utils::SleepForSeconds(1);
+			stateChanged = (state != stateBefore);
+		}
+
+		// other locos may be waiting for the released routes and tracks
+		if (routesReleased)
+		{
+			manager->LocoWakeUpAutoModeAll();
+		}
+
+		if (stateChanged)
+		{
+			nextCheck = std::chrono::steady_clock::now();
 		}
+		return true;
 	}
 
 	void Loco::SearchDestinationFirst()
 	{
-		if (routeFirst != nullptr)
+		if (blocks.empty() == false)
 		{
 			state = LocoStateError;
 			logger->Error(Languages::TextHasAlreadyReservedRoute, name);
@@ -398,19 +483,18 @@ namespace DataModel
 		manager->LocoOrientation(ControlTypeInternal, this, newLocoOrientation);
 		logger->Info(Languages::TextHeadingToVia, newTrack->GetMyName(), usedRoute->GetName());
 
-		trackFirst = newTrack;
-		routeFirst = usedRoute;
-		feedbackIdFirst = FeedbackNone;
-		feedbackIdReduced = routeFirst->GetFeedbackIdReduced();
-		feedbackIdCreep = routeFirst->GetFeedbackIdCreep();
-		feedbackIdStop = routeFirst->GetFeedbackIdStop();
-		feedbackIdOver = routeFirst->GetFeedbackIdOver();
-		wait = routeFirst->GetWaitAfterRelease();
+		blocks.push_back({ usedRoute, newTrack, false });
+		UpdateExactBraking();
+		feedbackIdReduced = usedRoute->GetFeedbackIdReduced();
+		feedbackIdCreep = usedRoute->GetFeedbackIdCreep();
+		feedbackIdStop = usedRoute->GetFeedbackIdStop();
+		feedbackIdOver = usedRoute->GetFeedbackIdOver();
+		wait = usedRoute->GetWaitAfterRelease();
 
 		// start loco
 		manager->TrackBasePublishState(newTrack);
 		Speed newSpeed;
-		switch (routeFirst->GetSpeed())
+		switch (usedRoute->GetSpeed())
 		{
 			case Route::SpeedTravel:
 				newSpeed = travelSpeed;
@@ -426,19 +510,22 @@ namespace DataModel
 				break;
 		}
 		manager->LocoSpeed(ControlTypeInternal, this, newSpeed);
-		state = LocoStateSearchingSecond;
+		blockEntered = std::chrono::steady_clock::now();
+		blockEnteredKnown = true;
+		state = LocoStateSearchingNext;
 	}
 
-	void Loco::SearchDestinationSecond()
+	void Loco::SearchDestinationNext()
 	{
-		Route* usedRoute = SearchDestination(trackFirst, false);
+		const Block& lastBlock = blocks.back();
+		Route* usedRoute = SearchDestination(lastBlock.track, false);
 		if (usedRoute == nullptr)
 		{
 			return;
 		}
 
-		const ObjectIdentifier& newTrackIdentifierSecond = usedRoute->GetToTrack();
-		TrackBase* newTrack = manager->GetTrackBase(newTrackIdentifierSecond);
+		const ObjectIdentifier& newTrackIdentifierNext = usedRoute->GetToTrack();
+		TrackBase* newTrack = manager->GetTrackBase(newTrackIdentifierNext);
 		if (newTrack == nullptr)
 		{
 			return;
@@ -449,38 +536,52 @@ namespace DataModel
 		{
 			return;
 		}
-		logger->Info(Languages::TextHeadingToViaVia, newTrack->GetMyName(), routeFirst->GetName(), usedRoute->GetName());
+		logger->Info(Languages::TextHeadingToViaVia, newTrack->GetMyName(), lastBlock.route->GetName(), usedRoute->GetName());
+
+		const Route::Speed speedNext = usedRoute->GetSpeed();
+		const bool preReserved = (blocks.size() >= manager->GetNrOfTracksToReserve());
+		if (preReserved)
+		{
+			logger->Debug(Languages::TextPreReservedRoute, usedRoute->GetName());
+		}
+		blocks.push_back({ usedRoute, newTrack, preReserved });
+		UpdateExactBraking();
+
+		// the loco may only speed up if all blocks from the current one to the new one allow it
+		Route::Speed speedSlowest = Route::SpeedMax;
+		for (const Block& block : blocks)
+		{
+			speedSlowest = std::min(speedSlowest, block.route->GetSpeed());
+		}
 
-		trackSecond = newTrack;
-		routeSecond = usedRoute;
-		feedbackIdFirst = feedbackIdStop;
-		feedbackIdOver = routeSecond->GetFeedbackIdOver();
-		feedbackIdStop = routeSecond->GetFeedbackIdStop();
-		Route::Speed speedFirst = routeFirst->GetSpeed();
-		Route::Speed speedSecond = routeSecond->GetSpeed();
-		if (speedSecond == Route::SpeedTravel)
+		feedbackIdOver = usedRoute->GetFeedbackIdOver();
+		feedbackIdStop = usedRoute->GetFeedbackIdStop();
+		if (speedNext == Route::SpeedTravel)
 		{
-			feedbackIdCreep = routeSecond->GetFeedbackIdCreep();
-			feedbackIdReduced = routeSecond->GetFeedbackIdReduced();
-			if (speedFirst == Route::SpeedTravel)
+			feedbackIdCreep = usedRoute->GetFeedbackIdCreep();
+			feedbackIdReduced = usedRoute->GetFeedbackIdReduced();
+			if (speedSlowest >= Route::SpeedTravel)
 			{
 				manager->LocoSpeed(ControlTypeInternal, this, travelSpeed);
 			}
 		}
-		else if (speedSecond == Route::SpeedReduced)
+		else if (speedNext == Route::SpeedReduced)
 		{
-			feedbackIdCreep = routeSecond->GetFeedbackIdCreep();
-			if (speedFirst == Route::SpeedReduced)
+			feedbackIdCreep = usedRoute->GetFeedbackIdCreep();
+			if (speedSlowest >= Route::SpeedReduced)
 			{
 				manager->LocoSpeed(ControlTypeInternal, this, reducedSpeed);
 			}
 		}
 
-		wait = routeSecond->GetWaitAfterRelease();
+		wait = usedRoute->GetWaitAfterRelease();
 
 		// start loco
 		manager->TrackBasePublishState(newTrack);
-		state = LocoStateRunning;
+		if (blocks.size() >= manager->GetNrOfTracksToReserve())
+		{
+			state = LocoStateRunning;
+		}
 	}
 
 	Route* Loco::SearchDestination(TrackBase* track, const bool allowLocoTurn)
@@ -489,14 +590,6 @@ namespace DataModel
 		{
 			return nullptr;
 		}
-		logger->Debug(Languages::TextLookingForDestination, track->GetMyName());
-		if (routeSecond != nullptr)
-		{
-			state = LocoStateError;
-			logger->Error(Languages::TextHasAlreadyReservedRoute, name);
-			return nullptr;
-		}
-
 		if (track == nullptr)
 		{
 			state = LocoStateOff;
@@ -504,6 +597,9 @@ namespace DataModel
 			return nullptr;
 		}
 
+		logger->Debug(Languages::TextLookingForDestination, track->GetMyName());
+		const std::chrono::steady_clock::time_point searchStarted = std::chrono::steady_clock::now();
+
 		LocoID locoIdOfTrack = track->GetMyLoco();
 		if (locoIdOfTrack != GetID())
 		{
@@ -514,18 +610,26 @@ namespace DataModel
 
 		vector<Route*> validRoutes;
 		track->GetValidRoutes(logger, this, allowLocoTurn, validRoutes);
+		RouteConflictMatrix::Bitset freeRoutes;
+		manager->RouteGetConflictFree(objectID, freeRoutes);
+		// every blocked route gets its own list, the loco can leave as soon as one of them is free
+		vector<vector<LocoID>> blockingLocos;
 		for (auto route : validRoutes)
 		{
-			logger->Debug(Languages::TextExecutingRoute, route->GetName());
-
-			if (route->Reserve(logger, objectID) == false)
+			if (RouteConflictMatrix::IsSet(freeRoutes, route->GetID()) == false)
 			{
+				// conflicts with a route of another loco, trying to reserve it is useless
+				blockingLocos.push_back(vector<LocoID>());
+				route->GetBlockingLocos(objectID, blockingLocos.back());
 				continue;
 			}
 
-			if (route->Lock(logger, objectID) == false)
+			logger->Debug(Languages::TextExecutingRoute, route->GetName());
+
+			if (manager->RouteReserveAndLock(logger, route, objectID) == false)
 			{
-				route->Release(logger, objectID);
+				blockingLocos.push_back(vector<LocoID>());
+				route->GetBlockingLocos(objectID, blockingLocos.back());
 				continue;
 			}
 
@@ -553,6 +657,17 @@ namespace DataModel
 				continue;
 			}
 
+			vector<LocoID> visitedLocos;
+			visitedLocos.push_back(objectID);
+			if (manager->LocoCanLeaveTrackBase(logger, this, newTrack, route->GetToOrientation(), visitedLocos, Manager::DeadlockLookaheadDepth) == false)
+			{
+				route->Release(logger, objectID);
+				newTrack->BaseRelease(logger, objectID);
+				manager->LocoDeadlockAvoided();
+				logger->Info(Languages::TextDeadlockAvoided, name, newTrack->GetMyName());
+				continue;
+			}
+
 			if (route->Execute(logger, objectID) == false)
 			{
 				route->Release(logger, objectID);
@@ -560,8 +675,19 @@ namespace DataModel
 				continue;
 			}
 
+			manager->LocoWaitsFor(objectID, vector<vector<LocoID>>());
+			const std::chrono::milliseconds setUpTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - searchStarted);
+			if (routeSetUpTime.count() == 0)
+			{
+				routeSetUpTime = setUpTime;
+			}
+			else
+			{
+				routeSetUpTime += (setUpTime - routeSetUpTime) / static_cast<unsigned int>(BlockTimeWeight);
+			}
 			return route;
 		}
+		manager->LocoWaitsFor(objectID, blockingLocos);
 		logger->Debug(Languages::TextNoValidRouteFound, name);
 		return nullptr;
 	}
@@ -570,7 +696,7 @@ namespace DataModel
 	{
 		if (feedbackID == feedbackIdOver)
 		{
-			manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+			manager->LocoStopImmediately(ControlTypeInternal, this);
 			manager->Booster(ControlTypeInternal, BoosterStateStop);
 			logger->Error(Languages::TextHitOverrun, name, manager->GetFeedbackName(feedbackID));
 			return;
@@ -578,47 +704,103 @@ namespace DataModel
 
 		if (feedbackID == feedbackIdStop)
 		{
-			manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
-			feedbackIdsReached.Enqueue(feedbackIdStop);
-			return;
+			// a deceleration ramp would roll past the stop feedback towards the overrun feedback
+			manager->LocoStopImmediately(ControlTypeInternal, this);
 		}
-
-		if (feedbackID == feedbackIdCreep)
+		// with exact braking the automode decides when to brake
+		else if (feedbackID == feedbackIdCreep && exactBraking == false && speed > creepingSpeed)
 		{
-			if (speed > creepingSpeed)
-			{
-				manager->LocoSpeed(ControlTypeInternal, this, creepingSpeed);
-			}
-			return;
+			manager->LocoSpeed(ControlTypeInternal, this, creepingSpeed);
 		}
-
-		if (feedbackID == feedbackIdReduced)
+		else if (feedbackID == feedbackIdReduced && exactBraking == false && speed > reducedSpeed)
 		{
-			if (speed > reducedSpeed)
-			{
-				manager->LocoSpeed(ControlTypeInternal, this, reducedSpeed);
-			}
-			return;
+			manager->LocoSpeed(ControlTypeInternal, this, reducedSpeed);
 		}
 
-		if (feedbackID == feedbackIdFirst)
+		// only the automode drains the queue, a manually driven loco would fill it up
+		if (IsInAutoMode() == false)
 		{
-			feedbackIdsReached.Enqueue(feedbackIdFirst);
 			return;
 		}
+
+		// it may be the stop feedback of a block in between or a braking feedback
+		feedbackIdsReached.Enqueue({ feedbackID, std::chrono::steady_clock::now() });
+		WakeUpAutoMode();
 	}
 
-	void Loco::SetSpeed(const Speed speed, const bool withSlaves)
+	void Loco::SetSpeed(const Speed speed)
 	{
+		std::lock_guard<std::mutex> Guard(speedMutex);
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		odometer = OdometerAt(now);
+		speedChanged = now;
 		this->speed = speed;
-		if (!withSlaves)
+	}
+
+	void Loco::SetSpeedTable(const SpeedTable& table)
+	{
+		std::lock_guard<std::mutex> Guard(speedMutex);
+		speedTable = table;
+	}
+
+	Loco::SpeedTable Loco::GetSpeedTable() const
+	{
+		std::lock_guard<std::mutex> Guard(speedMutex);
+		return speedTable;
+	}
+
+	unsigned int Loco::GetRealSpeed(const Speed speed) const
+	{
+		std::lock_guard<std::mutex> Guard(speedMutex);
+		return RealSpeed(speed);
+	}
+
+	unsigned int Loco::RealSpeed(const Speed speed) const
+	{
+		if (speed == MinSpeed || speedTable.empty())
 		{
-			return;
+			return 0;
 		}
-		for (auto slave : slaves)
+		auto upper = speedTable.lower_bound(speed);
+		if (upper != speedTable.end() && upper->first == speed)
+		{
+			return upper->second;
+		}
+		// interpolate linearly between the neighbouring steps, standstill and above the table proportionally to the step
+		Speed lowerStep = MinSpeed;
+		unsigned int lowerSpeed = 0;
+		if (upper != speedTable.begin())
+		{
+			auto lower = std::prev(upper);
+			lowerStep = lower->first;
+			lowerSpeed = lower->second;
+		}
+		if (upper == speedTable.end())
 		{
-			manager->LocoSpeed(ControlTypeInternal, slave->ObjectID2(), speed, false);
+			if (lowerStep == MinSpeed)
+			{
+				return lowerSpeed;
+			}
+			return static_cast<unsigned int>(static_cast<uint64_t>(lowerSpeed) * speed / lowerStep);
 		}
+		const int64_t difference = static_cast<int64_t>(upper->second) - static_cast<int64_t>(lowerSpeed);
+		return static_cast<unsigned int>(lowerSpeed + difference * (speed - lowerStep) / (upper->first - lowerStep));
+	}
+
+	double Loco::GetOdometer(const std::chrono::steady_clock::time_point at) const
+	{
+		std::lock_guard<std::mutex> Guard(speedMutex);
+		return OdometerAt(at);
+	}
+
+	double Loco::OdometerAt(const std::chrono::steady_clock::time_point at) const
+	{
+		if (at <= speedChanged)
+		{
+			return odometer;
+		}
+		const std::chrono::duration<double> driving = at - speedChanged;
+		return odometer + RealSpeed(speed) * driving.count();
 	}
 
 	void Loco::SetOrientation(const Orientation orientation)
@@ -630,18 +812,58 @@ namespace DataModel
 		}
 	}
 
-	void Loco::FeedbackIdFirstReached()
+	bool Loco::FeedbackReachedInternal(const FeedbackID feedbackID, const std::chrono::steady_clock::time_point reached)
 	{
-		if (routeFirst == nullptr || trackFrom == nullptr)
+		if (blocks.empty())
+		{
+			return false;
+		}
+
+		if (feedbackID == feedbackIdStop)
+		{
+			// all blocks before the last one are passed, even if their stop feedbacks have been missed
+			BlocksPassed(blocks.size() - 1, reached);
+			FeedbackIdStopReached(reached);
+			return true;
+		}
+
+		if (feedbackID == feedbackIdReduced || feedbackID == feedbackIdCreep)
+		{
+			BrakeFeedbackReached(reached);
+			return false;
+		}
+
+		for (size_t block = 0; block + 1 < blocks.size(); ++block)
 		{
-			manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+			if (blocks[block].route->GetFeedbackIdStop() != feedbackID)
+			{
+				continue;
+			}
+			// the previous blocks must be released too if their stop feedbacks have been missed
+			BlocksPassed(block + 1, reached);
+			return true;
+		}
+		return false;
+	}
+
+	void Loco::BlocksPassed(const size_t nrOfBlocks, const std::chrono::steady_clock::time_point reached)
+	{
+		if (nrOfBlocks == 0)
+		{
+			return;
+		}
+
+		if (trackFrom == nullptr)
+		{
+			manager->LocoStopImmediately(ControlTypeInternal, this);
 			state = LocoStateError;
 			logger->Error(Languages::TextIsInAutomodeWithoutRouteTrack, name);
 			return;
 		}
 
+		const FeedbackID feedbackIdPassed = blocks[nrOfBlocks - 1].route->GetFeedbackIdStop();
 		Speed newSpeed;
-		switch (routeFirst->GetSpeed())
+		switch (blocks[nrOfBlocks - 1].route->GetSpeed())
 		{
 			case Route::SpeedTravel:
 				newSpeed = travelSpeed;
@@ -662,21 +884,28 @@ namespace DataModel
 			manager->LocoSpeed(ControlTypeInternal, this, newSpeed);
 		}
 
-
-		routeFirst->Release(logger, objectID);
-		routeFirst = routeSecond;
-		routeSecond = nullptr;
-
-		trackFrom->BaseRelease(logger, objectID);
-		trackFrom = trackFirst;
-		trackFirst = trackSecond;
-		trackSecond = nullptr;
+		for (size_t block = 0; block < nrOfBlocks; ++block)
+		{
+			// the time is only known if no stop feedback has been missed
+			BlockLeft(blocks.front().route, reached, nrOfBlocks == 1);
+			blocks.front().route->Release(logger, objectID);
+			trackFrom->BaseRelease(logger, objectID);
+			trackFrom = blocks.front().track;
+			blocks.pop_front();
+			++blocksPassed;
+		}
+		if (blocks.empty() == false && blocks.front().preReserved)
+		{
+			// without the early reservation the loco would have stopped here
+			++stopsAvoided;
+		}
 
 		// set state
 		switch (state)
 		{
 			case LocoStateRunning:
-				state = LocoStateSearchingSecond;
+			case LocoStateSearchingNext:
+				state = LocoStateSearchingNext;
 				break;
 
 			case LocoStateStopping:
@@ -684,37 +913,54 @@ namespace DataModel
 				break;
 
 			default:
-				logger->Error(Languages::TextIsInInvalidAutomodeState, name, state, manager->GetFeedbackName(feedbackIdFirst));
+				logger->Error(Languages::TextIsInInvalidAutomodeState, name, state, manager->GetFeedbackName(feedbackIdPassed));
 				state = LocoStateError;
 				break;
 		}
-
-		feedbackIdFirst = FeedbackNone;
 	}
 
-	void Loco::FeedbackIdStopReached()
+	void Loco::FeedbackIdStopReached(const std::chrono::steady_clock::time_point reached)
 	{
-		if (routeFirst == nullptr || trackFrom == nullptr)
+		if (blocks.empty() || trackFrom == nullptr)
 		{
-			manager->LocoSpeed(ControlTypeInternal, this, MinSpeed);
+			manager->LocoStopImmediately(ControlTypeInternal, this);
 			state = LocoStateError;
 			logger->Error(Languages::TextIsInAutomodeWithoutRouteTrack, name);
 			return;
 		}
 
-		manager->LocoDestinationReached(this, routeFirst, trackFrom);
-		routeFirst->Release(logger, objectID);
-		routeFirst = nullptr;
+		Route* route = blocks.front().route;
+		BlockLeft(route, reached, true);
+		++stops;
+		if (brakeRoute == route->GetID() && GetRealSpeed(creepingSpeed) > 0)
+		{
+			const double stopDistance = GetOdometer(reached) - brakeOdometer;
+			auto stopDistanceIterator = stopDistances.find(brakeRoute);
+			if (stopDistanceIterator == stopDistances.end())
+			{
+				stopDistances[brakeRoute] = stopDistance;
+			}
+			else
+			{
+				stopDistanceIterator->second += (stopDistance - stopDistanceIterator->second) / BlockTimeWeight;
+			}
+		}
+		brakeRoute = RouteNone;
+		brakePlanned = false;
+		exactBraking = false;
+		manager->LocoDestinationReached(this, route, trackFrom);
+		route->Release(logger, objectID);
 
 		trackFrom->BaseRelease(logger, objectID);
-		trackFrom = trackFirst;
-		trackFirst = nullptr;
+		trackFrom = blocks.front().track;
+		blocks.pop_front();
 		logger->Info(Languages::TextReachedItsDestination, name);
 
 		// set state
 		switch (state)
 		{
-			case LocoStateSearchingSecond:
+			case LocoStateRunning:
+			case LocoStateSearchingNext:
 				state = LocoStateSearchingFirst;
 				break;
 
@@ -733,6 +979,114 @@ namespace DataModel
 		feedbackIdReduced = FeedbackNone;
 	}
 
+	void Loco::BlockLeft(const Route* route, const std::chrono::steady_clock::time_point reached, const bool measured)
+	{
+		if (measured && blockEnteredKnown)
+		{
+			const std::chrono::milliseconds blockTime = std::chrono::duration_cast<std::chrono::milliseconds>(reached - blockEntered);
+			const RouteID routeID = route->GetID();
+			auto blockTimeIterator = blockTimes.find(routeID);
+			if (blockTimeIterator == blockTimes.end())
+			{
+				blockTimes[routeID] = blockTime;
+			}
+			else
+			{
+				blockTimeIterator->second += (blockTime - blockTimeIterator->second) / static_cast<unsigned int>(BlockTimeWeight);
+			}
+		}
+		blockEntered = reached;
+		blockEnteredKnown = measured;
+	}
+
+	bool Loco::PreReservationDue(std::chrono::steady_clock::time_point& nextCheck) const
+	{
+		// only one block is reserved in advance
+		if (blocks.size() != manager->GetNrOfTracksToReserve() || blockEnteredKnown == false)
+		{
+			return false;
+		}
+
+		std::chrono::milliseconds expected(0);
+		for (auto& block : blocks)
+		{
+			auto blockTimeIterator = blockTimes.find(block.route->GetID());
+			if (blockTimeIterator == blockTimes.end())
+			{
+				// the loco has not driven this route yet, so the time to reserve is unknown
+				return false;
+			}
+			expected += blockTimeIterator->second;
+		}
+
+		const std::chrono::steady_clock::time_point reserveAt = blockEntered + expected - routeSetUpTime
+			- std::chrono::milliseconds(static_cast<unsigned int>(PreReservationMargin));
+		if (std::chrono::steady_clock::now() >= reserveAt)
+		{
+			return true;
+		}
+		nextCheck = std::min(nextCheck, reserveAt);
+		return false;
+	}
+
+	void Loco::UpdateExactBraking()
+	{
+		// only the last block ends with a stop
+		brakePlanned = false;
+		brakeRoute = RouteNone;
+		exactBraking = (GetRealSpeed(creepingSpeed) > 0 && stopDistances.count(blocks.back().route->GetID()) == 1);
+	}
+
+	void Loco::BrakeFeedbackReached(const std::chrono::steady_clock::time_point reached)
+	{
+		if (blocks.empty())
+		{
+			return;
+		}
+		const RouteID routeID = blocks.back().route->GetID();
+		if (brakeRoute == routeID)
+		{
+			// the distance is measured from the first braking feedback
+			return;
+		}
+		brakeRoute = routeID;
+		brakeOdometer = GetOdometer(reached);
+		if (exactBraking == false || speed <= creepingSpeed)
+		{
+			return;
+		}
+
+		// brake from the current speed to creeping speed as late as possible and creep only for a short time
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		const double driven = GetOdometer(now) - brakeOdometer;
+		const double realSpeed = GetRealSpeed(speed);
+		const double realCreepingSpeed = GetRealSpeed(creepingSpeed);
+		const double brakeTime = decelerationTime * static_cast<double>(speed - creepingSpeed) / MaxSpeed / 1000;
+		const double brakeDistance = (realSpeed + realCreepingSpeed) / 2 * brakeTime;
+		const double creepDistance = realCreepingSpeed * CreepTime / 1000;
+		const double remaining = stopDistances[routeID] - driven - brakeDistance - creepDistance;
+		if (remaining <= 0 || realSpeed == 0)
+		{
+			manager->LocoSpeed(ControlTypeInternal, this, creepingSpeed);
+			return;
+		}
+		const std::chrono::duration<double> untilBraking(remaining / realSpeed);
+		brakeAt = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(untilBraking);
+		brakePlanned = true;
+		logger->Debug(Languages::TextBrakingIn, name, std::chrono::duration_cast<std::chrono::milliseconds>(untilBraking).count());
+	}
+
+	void Loco::LogBlockStatistics() const
+	{
+		const uint64_t blocksDriven = blocksPassed + stops;
+		if (blocksDriven == 0)
+		{
+			return;
+		}
+		const uint64_t seconds = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - autoModeStarted).count() + 1;
+		logger->Info(Languages::TextBlockStatistics, name, blocksDriven, blocksDriven * 3600 / seconds, stops, stopsAvoided, stopsAvoided * 3600 / seconds);
+	}
+
 	void Loco::DeleteSlaves()
 	{
 		while (slaves.size() > 0)
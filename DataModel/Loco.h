@@ -20,9 +20,12 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
 #include <mutex>
 #include <string>
-#include <thread>
 #include <vector>
 
 #include "DataTypes.h"
@@ -44,10 +47,12 @@ namespace DataModel
 	class Loco : public Object, public HardwareHandle
 	{
 		public:
+			// every value from ReserveOne to ReserveMax is valid
 			enum NrOfTracksToReserve : unsigned char
 			{
 				ReserveOne = 1,
-				ReserveTwo = 2
+				ReserveTwo = 2,
+				ReserveMax = 8
 			};
 
 			inline Loco(Manager* manager, const LocoID locoID)
@@ -60,22 +65,33 @@ namespace DataModel
 				travelSpeed(0),
 				reducedSpeed(0),
 				creepingSpeed(0),
+				accelerationTime(0),
+				decelerationTime(0),
+				calibrationFeedbackStart(FeedbackNone),
+				calibrationFeedbackEnd(FeedbackNone),
+				calibrationDistance(0),
 				speed(MinSpeed),
+				odometer(0),
 				orientation(OrientationRight),
 				state(LocoStateManual),
 				requestManualMode(false),
 				trackFrom(nullptr),
-				trackFirst(nullptr),
-				trackSecond(nullptr),
-				routeFirst(nullptr),
-				routeSecond(nullptr),
-				feedbackIdFirst(FeedbackNone),
+				blocks(),
 				feedbackIdReduced(FeedbackNone),
 				feedbackIdCreep(FeedbackNone),
 				feedbackIdStop(FeedbackNone),
 				feedbackIdOver(FeedbackNone),
 				feedbackIdsReached(),
-				wait(0)
+				wait(0),
+				routeSetUpTime(0),
+				blockEnteredKnown(false),
+				blocksPassed(0),
+				stops(0),
+				stopsAvoided(0),
+				exactBraking(false),
+				brakeRoute(RouteNone),
+				brakeOdometer(0),
+				brakePlanned(false)
 			{
 				logger = Logger::Logger::GetLogger(GetName());
 			}
@@ -90,22 +106,33 @@ namespace DataModel
 				travelSpeed(0),
 				reducedSpeed(0),
 				creepingSpeed(0),
+				accelerationTime(0),
+				decelerationTime(0),
+				calibrationFeedbackStart(FeedbackNone),
+				calibrationFeedbackEnd(FeedbackNone),
+				calibrationDistance(0),
 				speed(MinSpeed),
+				odometer(0),
 				orientation(OrientationRight),
 				state(LocoStateManual),
 				requestManualMode(false),
 				trackFrom(nullptr),
-				trackFirst(nullptr),
-				trackSecond(nullptr),
-				routeFirst(nullptr),
-				routeSecond(nullptr),
-				feedbackIdFirst(FeedbackNone),
+				blocks(),
 				feedbackIdReduced(FeedbackNone),
 				feedbackIdCreep(FeedbackNone),
 				feedbackIdStop(FeedbackNone),
 				feedbackIdOver(FeedbackNone),
 				feedbackIdsReached(),
-				wait(0)
+				wait(0),
+				routeSetUpTime(0),
+				blockEnteredKnown(false),
+				blocksPassed(0),
+				stops(0),
+				stopsAvoided(0),
+				exactBraking(false),
+				brakeRoute(RouteNone),
+				brakeOdometer(0),
+				brakePlanned(false)
 			{
 				Deserialize(serialized);
 				logger = Logger::Logger::GetLogger(GetName());
@@ -138,12 +165,21 @@ namespace DataModel
 			bool GoToManualMode();
 
 			bool SetTrack(const DataModel::ObjectIdentifier& identifier);
+			// the track the loco stands on and the orientation it has there, false if it is not on a track
+			bool GetTrack(DataModel::ObjectIdentifier& identifier, Orientation& trackOrientation) const;
 			bool Release();
 			bool IsRunningFromTrack(const TrackID trackID) const;
 
 			void LocationReached(const FeedbackID feedbackID);
 
-			void SetSpeed(const Speed speed, const bool withSlaves);
+			// lets the automode check its state immediately instead of waiting for the idle recheck
+			void WakeUpAutoMode();
+
+			// one decision of the automode, called by the automode scheduler
+			// returns false if the loco is not in automode (anymore)
+			bool AutoModeStep(std::chrono::steady_clock::time_point& nextCheck);
+
+			void SetSpeed(const Speed speed);
 
 			inline Speed GetSpeed() const
 			{
@@ -199,7 +235,7 @@ namespace DataModel
 				return this->speed > 0
 					|| this->state != LocoStateManual
 					|| this->trackFrom != nullptr
-					|| this->routeFirst != nullptr;
+					|| this->blocks.empty() == false;
 			}
 
 			inline bool GetPushpull() const
@@ -237,6 +273,17 @@ namespace DataModel
 				return creepingSpeed;
 			}
 
+			// milliseconds from MinSpeed to MaxSpeed, 0 changes the speed at once
+			inline unsigned int GetAccelerationTime() const
+			{
+				return accelerationTime;
+			}
+
+			inline unsigned int GetDecelerationTime() const
+			{
+				return decelerationTime;
+			}
+
 			inline void SetPushpull(bool pushpull)
 			{
 				this->pushpull = pushpull;
@@ -262,6 +309,48 @@ namespace DataModel
 				creepingSpeed = speed;
 			}
 
+			inline void SetAccelerationTime(const unsigned int time)
+			{
+				accelerationTime = time;
+			}
+
+			inline void SetDecelerationTime(const unsigned int time)
+			{
+				decelerationTime = time;
+			}
+
+			// a measured section of known length between two feedbacks, used to calibrate the speed steps
+			inline FeedbackID GetCalibrationFeedbackStart() const
+			{
+				return calibrationFeedbackStart;
+			}
+
+			inline FeedbackID GetCalibrationFeedbackEnd() const
+			{
+				return calibrationFeedbackEnd;
+			}
+
+			// millimeters between the start and the end feedback
+			inline Length GetCalibrationDistance() const
+			{
+				return calibrationDistance;
+			}
+
+			inline void SetCalibration(const FeedbackID start, const FeedbackID end, const Length distance)
+			{
+				calibrationFeedbackStart = start;
+				calibrationFeedbackEnd = end;
+				calibrationDistance = distance;
+			}
+
+			// measured speed in millimeters per second of every calibrated speed step
+			typedef std::map<Speed,unsigned int> SpeedTable;
+
+			void SetSpeedTable(const SpeedTable& table);
+			SpeedTable GetSpeedTable() const;
+			// interpolated from the speed table, 0 if the loco is not calibrated
+			unsigned int GetRealSpeed(const Speed speed) const;
+
 			bool AssignSlaves(const std::vector<DataModel::Relation*>& newslaves);
 
 			inline const std::vector<DataModel::Relation*>& GetSlaves() const
@@ -270,13 +359,21 @@ namespace DataModel
 			}
 
 		private:
-			void SetMinThreadPriorityAndThreadName();
-			void AutoMode();
 			void SearchDestinationFirst();
-			void SearchDestinationSecond();
+			void SearchDestinationNext();
 			DataModel::Route* SearchDestination(DataModel::TrackBase* oldToTrack, const bool allowLocoTurn);
-			void FeedbackIdFirstReached();
-			void FeedbackIdStopReached();
+			bool FeedbackReachedInternal(const FeedbackID feedbackID, const std::chrono::steady_clock::time_point reached);
+			void BlocksPassed(const size_t nrOfBlocks, const std::chrono::steady_clock::time_point reached);
+			void FeedbackIdStopReached(const std::chrono::steady_clock::time_point reached);
+			void BlockLeft(const Route* route, const std::chrono::steady_clock::time_point reached, const bool measured);
+			bool PreReservationDue(std::chrono::steady_clock::time_point& nextCheck) const;
+			// distance driven in millimeters, extrapolated with the current speed
+			double GetOdometer(const std::chrono::steady_clock::time_point at) const;
+			double OdometerAt(const std::chrono::steady_clock::time_point at) const;
+			unsigned int RealSpeed(const Speed speed) const;
+			void UpdateExactBraking();
+			void BrakeFeedbackReached(const std::chrono::steady_clock::time_point reached);
+			void LogBlockStatistics() const;
 			void DeleteSlaves();
 			void ForceManualMode();
 
@@ -286,7 +383,7 @@ namespace DataModel
 				LocoStateTerminated,
 				LocoStateOff,
 				LocoStateSearchingFirst,
-				LocoStateSearchingSecond,
+				LocoStateSearchingNext,
 				LocoStateRunning,
 				LocoStateStopping,
 				LocoStateError
@@ -294,7 +391,8 @@ namespace DataModel
 
 			Manager* manager;
 			mutable std::mutex stateMutex;
-			std::thread locoThread;
+			// notified when the automode has terminated
+			std::condition_variable stateCondition;
 
 			Length length;
 			bool pushpull;
@@ -302,8 +400,18 @@ namespace DataModel
 			Speed travelSpeed;
 			Speed reducedSpeed;
 			Speed creepingSpeed;
+			unsigned int accelerationTime;
+			unsigned int decelerationTime;
+			FeedbackID calibrationFeedbackStart;
+			FeedbackID calibrationFeedbackEnd;
+			Length calibrationDistance;
+			SpeedTable speedTable;
 
 			Speed speed;
+			// odometer at the time of the last speed change
+			double odometer;
+			std::chrono::steady_clock::time_point speedChanged;
+			mutable std::mutex speedMutex;
 			Orientation orientation;
 
 			std::vector<DataModel::Relation*> slaves;
@@ -311,17 +419,51 @@ namespace DataModel
 			volatile LocoState state;
 			volatile bool requestManualMode;
 			TrackBase* trackFrom;
-			TrackBase* trackFirst;
-			TrackBase* trackSecond;
-			Route* routeFirst;
-			Route* routeSecond;
-			volatile FeedbackID feedbackIdFirst;
+			// reserved routes and their destination tracks, the first one is driven right now
+			struct Block
+			{
+				Route* route;
+				TrackBase* track;
+				bool preReserved;
+			};
+			std::deque<Block> blocks;
 			volatile FeedbackID feedbackIdReduced;
 			volatile FeedbackID feedbackIdCreep;
 			volatile FeedbackID feedbackIdStop;
 			volatile FeedbackID feedbackIdOver;
-			Utils::ThreadSafeQueue<FeedbackID> feedbackIdsReached;
+
+			struct FeedbackReached
+			{
+				FeedbackID feedbackID;
+				std::chrono::steady_clock::time_point reached;
+			};
+			Utils::ThreadSafeQueue<FeedbackReached> feedbackIdsReached;
 			Pause wait;
+			std::chrono::steady_clock::time_point waitUntil;
+
+			// running model of the time from entering a block until its stop feedback is reached,
+			// used to reserve the next block early enough that the loco does not have to brake
+			std::map<RouteID,std::chrono::milliseconds> blockTimes;
+			std::chrono::milliseconds routeSetUpTime;
+			std::chrono::steady_clock::time_point blockEntered;
+			bool blockEnteredKnown;
+			static const unsigned int PreReservationMargin = 2000; // milliseconds
+			static const unsigned int BlockTimeWeight = 4;
+
+			std::chrono::steady_clock::time_point autoModeStarted;
+			uint64_t blocksPassed;
+			uint64_t stops;
+			uint64_t stopsAvoided;
+
+			// running model of the distance from the first braking feedback to the stop feedback,
+			// with a calibrated loco it is used to brake as late as possible instead of creeping
+			std::map<RouteID,double> stopDistances;
+			volatile bool exactBraking;
+			RouteID brakeRoute;
+			double brakeOdometer;
+			bool brakePlanned;
+			std::chrono::steady_clock::time_point brakeAt;
+			static const unsigned int CreepTime = 1000; // milliseconds
 
 			LocoFunctions functions;
 
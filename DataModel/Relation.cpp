@@ -212,6 +212,26 @@ namespace DataModel
 		return false;
 	}
 
+	bool Relation::CanReserveAndLock(const LocoID locoID)
+	{
+		if (LockableItem::CanReserveAndLock(locoID) == false)
+		{
+			return false;
+		}
+
+		if (ObjectType2() == ObjectTypeLoco)
+		{
+			return true;
+		}
+
+		LockableItem* lockable = GetObject2();
+		if (lockable == nullptr)
+		{
+			return false;
+		}
+		return lockable->CanReserveAndLock(locoID);
+	}
+
 	bool Relation::Release(Logger::Logger* logger, const LocoID locoID)
 	{
 		LockableItem* object = GetObject2();
@@ -29,12 +29,13 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/Serializable.h"
 #include "DataTypes.h"
 #include "Logger/Logger.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
 namespace DataModel
 {
-	class Relation : protected Serializable, public LockableItem
+	class Relation : protected Serializable, public LockableItem, public Utils::PoolAllocated<Relation>
 	{
 		public:
 			enum Type : unsigned char
@@ -125,6 +126,7 @@ namespace DataModel
 			bool Reserve(Logger::Logger* logger, const LocoID locoID) override;
 			bool Lock(Logger::Logger* logger, const LocoID locoID) override;
 			bool Release(Logger::Logger* logger, const LocoID locoID) override;
+			bool CanReserveAndLock(const LocoID locoID) override;
 			bool Execute(Logger::Logger* logger, const LocoID locoID, const Delay delay);
 
 		private:
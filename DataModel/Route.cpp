@@ -18,6 +18,8 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
+#include <chrono>
 #include <map>
 #include <string>
 
@@ -250,21 +252,45 @@ namespace DataModel
 			return false;
 		}
 
-		std::lock_guard<std::mutex> Guard(updateMutex);
-		for (auto relation : relationsAtLock)
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		// In batches all relations are sent at once. Every control gets its commands through its own
+		// queue, so the controls work in parallel and each hardware keeps its own gap between commands.
+		const bool inBatches = manager->GetExecuteRoutesInBatches();
+		std::vector<ObjectIdentifier> accessories;
 		{
-			bool retRelation = relation->Execute(logger, locoID, delay);
-			if (retRelation == false)
+			std::lock_guard<std::mutex> Guard(updateMutex);
+			for (auto relation : relationsAtLock)
 			{
-				return false;
+				bool retRelation = relation->Execute(logger, locoID, inBatches ? 0 : delay);
+				if (retRelation == false)
+				{
+					return false;
+				}
+				switch (relation->ObjectType2())
+				{
+					case ObjectTypeAccessory:
+					case ObjectTypeSwitch:
+					case ObjectTypeSignal:
+						accessories.push_back(ObjectIdentifier(relation->ObjectType2(), relation->ObjectID2()));
+						break;
+
+					default:
+						break;
+				}
+			}
+			lastUsed = time(nullptr);
+			++counter;
+			if (isInUse)
+			{
+				executeAtUnlock = true;
 			}
 		}
-		lastUsed = time(nullptr);
-		++counter;
-		if (isInUse)
+		if (inBatches)
 		{
-			executeAtUnlock = true;
+			// only the commands of this route are waited for and updateMutex is not held meanwhile
+			manager->WaitUntilAccessoryPulsesDone(accessories);
 		}
+		logger->Debug(Languages::TextRouteSetUpTime, GetName(), std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
 
 		if (fromTrack.GetObjectType() == ObjectTypeSignal)
 		{
@@ -320,6 +346,38 @@ namespace DataModel
 		return true;
 	}
 
+	bool Route::CanReserveAndLock(const LocoID locoID)
+	{
+		if (manager->Booster() == BoosterStateStop)
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> Guard(updateMutex);
+		if (LockableItem::CanReserveAndLock(locoID) == false)
+		{
+			return false;
+		}
+
+		if (automode == AutomodeYes)
+		{
+			TrackBase* track = manager->GetTrackBase(toTrack);
+			if (track == nullptr || track->BaseCanReserveAndLock(locoID) == false)
+			{
+				return false;
+			}
+		}
+
+		for (auto relation : relationsAtLock)
+		{
+			if (relation->CanReserveAndLock(locoID) == false)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
 	bool Route::Lock(Logger::Logger* logger, const LocoID locoID)
 	{
 		if (manager->Booster() == BoosterStateStop)
@@ -406,23 +464,62 @@ namespace DataModel
 		ReleaseInternal(logger, locoID);
 	}
 
-	bool Route::ObjectIsPartOfRoute(const ObjectIdentifier& identifier) const
+	void Route::GetLockedObjects(std::vector<ObjectIdentifier>& objects) const
+	{
+		objects.push_back(ObjectIdentifier(ObjectTypeRoute, GetID()));
+		if (fromTrack.IsSet())
+		{
+			objects.push_back(fromTrack);
+		}
+		if (toTrack.IsSet())
+		{
+			objects.push_back(toTrack);
+		}
+		for (auto relation : relationsAtLock)
+		{
+			if (relation->ObjectType2() == ObjectTypeLoco)
+			{
+				continue;
+			}
+			objects.push_back(ObjectIdentifier(relation->ObjectType2(), relation->ObjectID2()));
+		}
+	}
+
+	void Route::GetBlockingLocos(const LocoID locoID, std::vector<LocoID>& locos)
 	{
+		std::vector<LocoID> holders;
+		holders.push_back(GetLoco());
+		TrackBase* track = manager->GetTrackBase(toTrack);
+		if (track != nullptr)
+		{
+			holders.push_back(track->GetMyLoco());
+			holders.push_back(track->GetLocoDelayed());
+		}
 		for (auto relation : relationsAtLock)
 		{
-			if (relation->CompareObject2(identifier))
+			if (relation->ObjectType2() == ObjectTypeLoco)
+			{
+				continue;
+			}
+			LockableItem* lockable = relation->GetObject2();
+			if (lockable != nullptr)
 			{
-				return true;
+				holders.push_back(lockable->GetLoco());
 			}
 		}
-		for (auto relation : relationsAtUnlock)
+
+		for (auto holder : holders)
 		{
-			if (relation->CompareObject2(identifier))
+			if (holder == LocoNone || holder == locoID)
 			{
-				return true;
+				continue;
 			}
+			if (std::find(locos.begin(), locos.end(), holder) != locos.end())
+			{
+				continue;
+			}
+			locos.push_back(holder);
 		}
-		return false;
 	}
 } // namespace DataModel
 
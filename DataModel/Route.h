@@ -29,6 +29,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LockableItem.h"
 #include "DataModel/ObjectIdentifier.h"
 #include "Logger/Logger.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
@@ -37,7 +38,7 @@ namespace DataModel
 	class Loco;
 	class Relation;
 
-	class Route : public LayoutItem, public LockableItem
+	class Route : public LayoutItem, public LockableItem, public Utils::PoolAllocated<Route>
 	{
 		public:
 			static const Delay DefaultDelay = 250;
@@ -149,6 +150,7 @@ namespace DataModel
 			}
 
 			bool Reserve(Logger::Logger* logger, const LocoID locoID) override;
+			bool CanReserveAndLock(const LocoID locoID) override;
 			bool Lock(Logger::Logger* logger, const LocoID locoID) override;
 			bool Release(Logger::Logger* logger, const LocoID locoID) override;
 
@@ -316,7 +318,11 @@ namespace DataModel
 				return s1->GetLastUsed() < s2->GetLastUsed();
 			}
 
-			bool ObjectIsPartOfRoute(const ObjectIdentifier& identifier) const;
+			// all objects that are reserved and locked together with the route
+			void GetLockedObjects(std::vector<ObjectIdentifier>& objects) const;
+
+			// adds the other locos that hold the route or one of its objects
+			void GetBlockingLocos(const LocoID locoID, std::vector<LocoID>& locos);
 
 		private:
 			bool ReleaseInternal(Logger::Logger* logger, const LocoID locoID);
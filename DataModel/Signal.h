@@ -27,12 +27,13 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LockableItem.h"
 #include "DataModel/TrackBase.h"
 #include "DataTypes.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
 namespace DataModel
 {
-	class Signal : public AccessoryBase, public TrackBase, public LayoutItem, public LockableItem
+	class Signal : public AccessoryBase, public TrackBase, public LayoutItem, public LockableItem, public Utils::PoolAllocated<Signal>
 	{
 		public:
 			inline Signal(Manager* manager, const SignalID signalID)
@@ -82,6 +83,11 @@ namespace DataModel
 				return BaseReserveForce(logger, locoID);
 			}
 
+			inline bool CanReserveAndLock(const LocoID locoID) override
+			{
+				return BaseCanReserveAndLock(locoID);
+			}
+
 			inline bool Lock(Logger::Logger* logger, const LocoID locoID) override
 			{
 				return BaseLock(logger, locoID);
@@ -108,6 +114,11 @@ namespace DataModel
 				return LockableItem::Lock(logger, locoID);
 			}
 
+			inline bool CanReserveAndLockInternal(const LocoID locoID) override
+			{
+				return LockableItem::CanReserveAndLock(locoID);
+			}
+
 			bool ReleaseInternal(Logger::Logger* logger, const LocoID locoID) override;
 
 			void PublishState() const override;
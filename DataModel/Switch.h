@@ -26,12 +26,13 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/LayoutItem.h"
 #include "DataModel/LockableItem.h"
 #include "DataTypes.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
 namespace DataModel
 {
-	class Switch : public AccessoryBase, public LayoutItem, public LockableItem
+	class Switch : public AccessoryBase, public LayoutItem, public LockableItem, public Utils::PoolAllocated<Switch>
 	{
 		public:
 			Switch(const SwitchID switchID)
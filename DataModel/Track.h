@@ -29,6 +29,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "DataModel/TrackBase.h"
 #include "DataTypes.h"
 #include "Logger/Logger.h"
+#include "Utils/ObjectPool.h"
 
 class Manager;
 
@@ -37,7 +38,7 @@ namespace DataModel
 	class Loco;
 	class Route;
 
-	class Track : public TrackBase, public LayoutItem, public LockableItem
+	class Track : public TrackBase, public LayoutItem, public LockableItem, public Utils::PoolAllocated<Track>
 	{
 		public:
 			inline Track(Manager* manager, const TrackID trackID)
@@ -86,6 +87,11 @@ namespace DataModel
 				return BaseReserveForce(logger, locoID);
 			}
 
+			inline bool CanReserveAndLock(const LocoID locoID) override
+			{
+				return BaseCanReserveAndLock(locoID);
+			}
+
 			inline bool Lock(Logger::Logger* logger, const LocoID locoID) override
 			{
 				return BaseLock(logger, locoID);
@@ -112,6 +118,11 @@ namespace DataModel
 				return LockableItem::Lock(logger, locoID);
 			}
 
+			inline bool CanReserveAndLockInternal(const LocoID locoID) override
+			{
+				return LockableItem::CanReserveAndLock(locoID);
+			}
+
 			inline bool ReleaseInternal(Logger::Logger* logger, const LocoID locoID) override
 			{
 				return LockableItem::Release(logger, locoID);
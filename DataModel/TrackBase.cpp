@@ -146,6 +146,20 @@ namespace DataModel
 		return true;
 	}
 
+	bool TrackBase::BaseCanReserveAndLock(const LocoID locoID)
+	{
+		std::lock_guard<std::mutex> Guard(updateMutex);
+		if (this->locoIdDelayed != LocoNone && this->locoIdDelayed != locoID)
+		{
+			return false;
+		}
+		if (blocked == true || trackState != DataModel::Feedback::FeedbackStateFree)
+		{
+			return false;
+		}
+		return CanReserveAndLockInternal(locoID);
+	}
+
 	bool TrackBase::BaseLock(Logger::Logger* logger, const LocoID locoID)
 	{
 		bool ret = LockInternal(logger, locoID);
@@ -223,7 +237,8 @@ namespace DataModel
 			Loco* loco = manager->GetLoco(GetLocoDelayed());
 			if (loco == nullptr)
 			{
-				if (blocked == false && manager->GetStopOnFeedbackInFreeTrack())
+				// a loco that is calibrated is not on a track, it drives round its whole loop
+				if (blocked == false && manager->GetStopOnFeedbackInFreeTrack() && manager->LocoCalibrationRunning() == false)
 				{
 					manager->Booster(ControlTypeInternal, BoosterStateStop);
 					blocked = true;
@@ -286,6 +301,7 @@ namespace DataModel
 			}
 		}
 		routes.push_back(route);
+		routeCandidates.clear();
 		return true;
 	}
 
@@ -295,6 +311,7 @@ namespace DataModel
 		size_t sizeBefore = routes.size();
 		routes.erase(std::remove(routes.begin(), routes.end(), route), routes.end());
 		size_t sizeAfter = routes.size();
+		routeCandidates.clear();
 		return sizeBefore > sizeAfter;
 	}
 
@@ -312,21 +329,52 @@ namespace DataModel
 		const bool allowLocoTurn,
 		std::vector<Route*>& validRoutes) const
 	{
-		std::lock_guard<std::mutex> Guard(updateMutex);
-		for (auto route : routes)
+		return GetValidRoutes(logger, loco, locoOrientation, allowLocoTurn, validRoutes);
+	}
+
+	bool TrackBase::GetValidRoutes(Logger::Logger* logger,
+		const Loco* loco,
+		const Orientation orientation,
+		const bool allowLocoTurn,
+		std::vector<Route*>& validRoutes) const
+	{
+		const SelectRouteApproach approach = GetSelectRouteApproachCalculated();
 		{
-			if (route->FromTrackOrientation(logger, GetObjectIdentifier(), locoOrientation, loco, allowLocoTurn))
+			std::lock_guard<std::mutex> Guard(updateMutex);
+			const RouteCandidateKey key = GetRouteCandidateKey(orientation,
+				allowLocoTurn,
+				loco->GetPushpull(),
+				loco->GetLength(),
+				approach);
+			auto candidates = routeCandidates.find(key);
+			if (candidates != routeCandidates.end())
 			{
-				validRoutes.push_back(route);
+				validRoutes = candidates->second;
+			}
+			else
+			{
+				for (auto route : routes)
+				{
+					if (route->FromTrackOrientation(logger, GetObjectIdentifier(), orientation, loco, allowLocoTurn))
+					{
+						validRoutes.push_back(route);
+					}
+				}
+				if (approach == SelectRouteMinTrackLength)
+				{
+					// the order does not change as long as the routes do not change
+					std::stable_sort(validRoutes.begin(), validRoutes.end(), Route::CompareShortest);
+				}
+				routeCandidates[key] = validRoutes;
 			}
 		}
-		OrderValidRoutes(validRoutes);
+		OrderValidRoutes(approach, validRoutes);
 		return true;
 	}
 
-	void TrackBase::OrderValidRoutes(vector<Route*>& validRoutes) const
+	void TrackBase::OrderValidRoutes(const SelectRouteApproach approach, vector<Route*>& validRoutes) const
 	{
-		switch (GetSelectRouteApproachCalculated())
+		switch (approach)
 		{
 
 			case SelectRouteRandom:
@@ -334,7 +382,7 @@ namespace DataModel
 				break;
 
 			case SelectRouteMinTrackLength:
-				std::sort(validRoutes.begin(), validRoutes.end(), Route::CompareShortest);
+				// already ordered in the candidate list
 				break;
 
 			case SelectRouteLongestUnused:
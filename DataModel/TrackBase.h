@@ -119,6 +119,13 @@ namespace DataModel
 				const bool allowLocoTurn,
 				std::vector<Route*>& validRoutes) const;
 
+			// valid routes if the loco would stand on the track in this orientation
+			bool GetValidRoutes(Logger::Logger* logger,
+				const DataModel::Loco* loco,
+				const Orientation orientation,
+				const bool allowLocoTurn,
+				std::vector<Route*>& validRoutes) const;
+
 			inline Orientation GetLocoOrientation() const
 			{
 				return locoOrientation;
@@ -183,7 +190,9 @@ namespace DataModel
 
 			inline void SetAllowLocoTurn(bool allowLocoTurn)
 			{
+				std::lock_guard<std::mutex> Guard(updateMutex);
 				this->allowLocoTurn = allowLocoTurn;
+				routeCandidates.clear();
 			}
 
 			inline FeedbackID GetFirstFeedbackId()
@@ -204,6 +213,7 @@ namespace DataModel
 
 			bool BaseReserve(Logger::Logger* logger, const LocoID locoID);
 			bool BaseReserveForce(Logger::Logger* logger, const LocoID locoID);
+			bool BaseCanReserveAndLock(const LocoID locoID);
 			bool BaseLock(Logger::Logger* logger, const LocoID locoID);
 			bool BaseRelease(Logger::Logger* logger, const LocoID locoID);
 			bool BaseReleaseForce(Logger::Logger* logger, const LocoID locoID);
@@ -214,6 +224,7 @@ namespace DataModel
 
 			virtual bool ReserveInternal(Logger::Logger* logger, const LocoID locoID) = 0;
 			virtual bool LockInternal(Logger::Logger* logger, const LocoID locoID) = 0;
+			virtual bool CanReserveAndLockInternal(const LocoID locoID) = 0;
 			virtual bool ReleaseInternal(Logger::Logger* logger, const LocoID locoID) = 0;
 			virtual void PublishState() const = 0;
 			virtual LocoID GetLockedLoco() const = 0;
@@ -222,7 +233,22 @@ namespace DataModel
 
 		private:
 			bool FeedbackStateInternal(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
-			void OrderValidRoutes(std::vector<DataModel::Route*>& validRoutes) const;
+			// all properties of track and loco that are checked by Route::FromTrackOrientation
+			typedef uint64_t RouteCandidateKey;
+			static inline RouteCandidateKey GetRouteCandidateKey(const Orientation orientation,
+				const bool allowLocoTurn,
+				const bool pushpull,
+				const Length length,
+				const SelectRouteApproach approach)
+			{
+				return (static_cast<RouteCandidateKey>(approach) << 40)
+					| (static_cast<RouteCandidateKey>(pushpull) << 34)
+					| (static_cast<RouteCandidateKey>(allowLocoTurn) << 33)
+					| (static_cast<RouteCandidateKey>(orientation) << 32)
+					| static_cast<RouteCandidateKey>(length);
+			}
+
+			void OrderValidRoutes(const SelectRouteApproach approach, std::vector<DataModel::Route*>& validRoutes) const;
 			SelectRouteApproach GetSelectRouteApproachCalculated() const;
 			bool BaseReleaseForceUnlocked(Logger::Logger* logger, const LocoID locoID);
 
@@ -233,6 +259,8 @@ namespace DataModel
 			DataModel::Feedback::FeedbackState trackState;
 			DataModel::Feedback::FeedbackState trackStateDelayed;
 			std::vector<Route*> routes;
+			// valid routes per loco class, cleared whenever routes are added or removed
+			mutable std::map<RouteCandidateKey,std::vector<Route*>> routeCandidates;
 			Orientation locoOrientation;
 			bool blocked;
 			LocoID locoIdDelayed;
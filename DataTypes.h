@@ -85,6 +85,8 @@ static const Speed DefaultTravelSpeed = 700;
 static const Speed DefaultReducedSpeed = 400;
 static const Speed DefaultCreepingSpeed = 100;
 static const Speed MinSpeed = 0;
+// milliseconds of a speed ramp from MinSpeed to MaxSpeed
+static const unsigned int MaxRampTime = 60000;
 
 enum ControlType : uint8_t
 {
@@ -0,0 +1,256 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Hardware/AccessoryPulseScheduler.h"
+#include "Hardware/HardwareInterface.h"
+#include "Utils/Utils.h"
+
+namespace Hardware
+{
+	AccessoryPulseScheduler::AccessoryPulseScheduler(HardwareInterface* hardware)
+	:	hardware(hardware),
+		maxActivePulses(hardware->GetMaxActiveAccessoryPulses() == 0 ? 1 : hardware->GetMaxActiveAccessoryPulses()),
+		commandGap(hardware->GetAccessoryCommandGap()),
+		nextOn(std::chrono::steady_clock::now()),
+		lastSequence(0),
+		run(true)
+	{
+		workerThread = std::thread(&AccessoryPulseScheduler::Worker, this);
+	}
+
+	AccessoryPulseScheduler::~AccessoryPulseScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> guard(pulseMutex);
+			run = false;
+			pulseCondition.notify_all();
+		}
+		workerThread.join();
+	}
+
+	AccessoryPulseScheduler::Sequence AccessoryPulseScheduler::Pulse(const Protocol protocol,
+		const Address address,
+		const DataModel::AccessoryState state,
+		const DataModel::AccessoryPulseDuration duration,
+		const Sequence after)
+	{
+		std::lock_guard<std::mutex> guard(pulseMutex);
+
+		PulseEntry pulse;
+		pulse.protocol = protocol;
+		pulse.address = address;
+		pulse.state = state;
+		pulse.duration = duration;
+		pulse.sequence = ++lastSequence;
+		if (pulse.sequence == SequenceNone)
+		{
+			pulse.sequence = ++lastSequence;
+		}
+		pulse.after = after;
+
+		// a new command for an output that is still on ends the running pulse, the worker switches it off first
+		for (auto activePulse = activePulses.begin(); activePulse != activePulses.end(); ++activePulse)
+		{
+			if (activePulse->second.protocol != protocol || activePulse->second.address != address)
+			{
+				continue;
+			}
+			PulseEntry endedPulse = activePulse->second;
+			activePulses.erase(activePulse);
+			activePulses.insert(ActivePulses::value_type(std::chrono::steady_clock::time_point::min(), endedPulse));
+			break;
+		}
+
+		// a waiting command for the same output is outdated
+		for (auto waitingPulse = waitingPulses.begin(); waitingPulse != waitingPulses.end(); ++waitingPulse)
+		{
+			if (waitingPulse->protocol != protocol || waitingPulse->address != address)
+			{
+				continue;
+			}
+			waitingPulses.erase(waitingPulse);
+			break;
+		}
+
+		waitingPulses.push_back(pulse);
+		pulseCondition.notify_all();
+		return pulse.sequence;
+	}
+
+	void AccessoryPulseScheduler::WaitUntilIdle(const Protocol protocol, const Address address)
+	{
+		std::unique_lock<std::mutex> lock(pulseMutex);
+		while (run && IsPending(protocol, address))
+		{
+			pulseCondition.wait(lock);
+		}
+	}
+
+	bool AccessoryPulseScheduler::IsPending(const Protocol protocol, const Address address) const
+	{
+		for (auto& activePulse : activePulses)
+		{
+			if (activePulse.second.protocol == protocol && activePulse.second.address == address)
+			{
+				return true;
+			}
+		}
+		for (auto& waitingPulse : waitingPulses)
+		{
+			if (waitingPulse.protocol == protocol && waitingPulse.address == address)
+			{
+				return true;
+			}
+		}
+		for (auto& sendingPulse : sendingPulses)
+		{
+			if (sendingPulse.pulse.protocol == protocol && sendingPulse.pulse.address == address)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool AccessoryPulseScheduler::IsPending(const Sequence sequence) const
+	{
+		for (auto& activePulse : activePulses)
+		{
+			if (activePulse.second.sequence == sequence)
+			{
+				return true;
+			}
+		}
+		for (auto& waitingPulse : waitingPulses)
+		{
+			if (waitingPulse.sequence == sequence)
+			{
+				return true;
+			}
+		}
+		for (auto& sendingPulse : sendingPulses)
+		{
+			if (sendingPulse.pulse.sequence == sequence)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AccessoryPulseScheduler::StartWaitingPulses(const std::chrono::steady_clock::time_point& now)
+	{
+		auto waitingPulse = waitingPulses.begin();
+		while (waitingPulse != waitingPulses.end()
+			&& activePulses.size() < maxActivePulses
+			&& now >= nextOn)
+		{
+			// a chained pulse lets the pulses of other outputs pass until its predecessor is off
+			if (waitingPulse->after != SequenceNone && IsPending(waitingPulse->after))
+			{
+				++waitingPulse;
+				continue;
+			}
+			nextOn = now + commandGap;
+			activePulses.insert(ActivePulses::value_type(now + std::chrono::milliseconds(waitingPulse->duration), *waitingPulse));
+			sendingPulses.push_back({ *waitingPulse, true });
+			waitingPulse = waitingPulses.erase(waitingPulse);
+		}
+	}
+
+	bool AccessoryPulseScheduler::HasStartablePulse() const
+	{
+		for (auto& waitingPulse : waitingPulses)
+		{
+			if (waitingPulse.after == SequenceNone || IsPending(waitingPulse.after) == false)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void AccessoryPulseScheduler::SendPulses(std::unique_lock<std::mutex>& lock)
+	{
+		// sendingPulses is only changed by the worker thread, the others only read it under the lock
+		const std::vector<SendEntry> pulses = sendingPulses;
+		lock.unlock();
+		for (auto& pulse : pulses)
+		{
+			hardware->AccessoryOnOrOff(pulse.pulse.protocol, pulse.pulse.address, pulse.pulse.state, pulse.on);
+		}
+		lock.lock();
+		sendingPulses.clear();
+		pulseCondition.notify_all();
+	}
+
+	void AccessoryPulseScheduler::Worker()
+	{
+		Utils::Utils::SetThreadName("Accessory Pulses");
+		std::unique_lock<std::mutex> lock(pulseMutex);
+		while (run)
+		{
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			while (activePulses.empty() == false && activePulses.begin()->first <= now)
+			{
+				sendingPulses.push_back({ activePulses.begin()->second, false });
+				activePulses.erase(activePulses.begin());
+			}
+			StartWaitingPulses(now);
+			if (sendingPulses.empty() == false)
+			{
+				SendPulses(lock);
+				continue;
+			}
+
+			if (activePulses.empty() && waitingPulses.empty())
+			{
+				pulseCondition.wait(lock);
+				continue;
+			}
+
+			// wake up when the next output is due to be switched off or a waiting pulse may be started,
+			// a pulse chained to an active one can only start after that one is switched off
+			std::chrono::steady_clock::time_point wakeUp = std::chrono::steady_clock::time_point::max();
+			if (activePulses.empty() == false)
+			{
+				wakeUp = activePulses.begin()->first;
+			}
+			if (activePulses.size() < maxActivePulses && nextOn > now && nextOn < wakeUp && HasStartablePulse())
+			{
+				wakeUp = nextOn;
+			}
+			if (wakeUp == std::chrono::steady_clock::time_point::max())
+			{
+				pulseCondition.wait(lock);
+				continue;
+			}
+			pulseCondition.wait_until(lock, wakeUp);
+		}
+
+		// no output may stay on when the hardware gets closed
+		for (auto& activePulse : activePulses)
+		{
+			sendingPulses.push_back({ activePulse.second, false });
+		}
+		activePulses.clear();
+		SendPulses(lock);
+	}
+} // namespace Hardware
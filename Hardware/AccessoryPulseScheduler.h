@@ -0,0 +1,109 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataModel/AccessoryBase.h"
+#include "DataTypes.h"
+
+namespace Hardware
+{
+	class HardwareInterface;
+
+	// Switches accessory outputs off when their pulse duration is over. The caller is not blocked
+	// for the pulse duration, so the pulses to different decoders overlap. At most
+	// GetMaxActiveAccessoryPulses() outputs of a hardware are on at the same time, further
+	// pulses wait until an output has been switched off. Two outputs are switched on at least
+	// GetAccessoryCommandGap() apart. Only the worker thread talks to the hardware, and it does
+	// so without holding pulseMutex, so the commands of one hardware keep their order.
+	class AccessoryPulseScheduler
+	{
+		public:
+			AccessoryPulseScheduler() = delete;
+			AccessoryPulseScheduler(HardwareInterface* hardware);
+			~AccessoryPulseScheduler();
+
+			typedef unsigned int Sequence;
+			static const Sequence SequenceNone = 0;
+
+			// The output is not switched on before the pulse after has been switched off, e.g. the
+			// two drives of a three way switch. Returns the sequence of the new pulse.
+			Sequence Pulse(const Protocol protocol,
+				const Address address,
+				const DataModel::AccessoryState state,
+				const DataModel::AccessoryPulseDuration duration,
+				const Sequence after = SequenceNone);
+
+			// returns when no pulse of this output is active or waiting anymore
+			void WaitUntilIdle(const Protocol protocol, const Address address);
+
+		private:
+			struct PulseEntry
+			{
+				Protocol protocol;
+				Address address;
+				DataModel::AccessoryState state;
+				DataModel::AccessoryPulseDuration duration;
+				Sequence sequence;
+				// SequenceNone or the pulse that has to be switched off before this one may start
+				Sequence after;
+			};
+
+			struct SendEntry
+			{
+				PulseEntry pulse;
+				bool on;
+			};
+
+			typedef std::multimap<std::chrono::steady_clock::time_point,PulseEntry> ActivePulses;
+
+			void Worker();
+			// pulseMutex must be locked when calling the following functions
+			void StartWaitingPulses(const std::chrono::steady_clock::time_point& now);
+			// returns false if all waiting pulses wait for their predecessor to be switched off
+			bool HasStartablePulse() const;
+			bool IsPending(const Sequence sequence) const;
+			bool IsPending(const Protocol protocol, const Address address) const;
+			void SendPulses(std::unique_lock<std::mutex>& lock);
+
+			HardwareInterface* hardware;
+			const size_t maxActivePulses;
+			const std::chrono::milliseconds commandGap;
+			std::chrono::steady_clock::time_point nextOn;
+			Sequence lastSequence;
+			// ordered by the time when the output has to be switched off
+			ActivePulses activePulses;
+			std::deque<PulseEntry> waitingPulses;
+			// commands the worker is sending right now
+			std::vector<SendEntry> sendingPulses;
+			std::mutex pulseMutex;
+			std::condition_variable pulseCondition;
+			volatile bool run;
+			std::thread workerThread;
+	};
+} // namespace Hardware
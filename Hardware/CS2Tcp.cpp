@@ -49,6 +49,11 @@ namespace Hardware
 		Init();
 	}
 
+	CS2Tcp::~CS2Tcp()
+	{
+		StopFrameSender();
+	}
+
 	void CS2Tcp::Send(const unsigned char* buffer)
 	{
 		if (connection.Send(buffer, CANCommandBufferLength) == -1)
@@ -31,6 +31,7 @@ namespace Hardware
 	{
 		public:
 			CS2Tcp(HardwareParams* const params);
+			~CS2Tcp();
 
 			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
 			{
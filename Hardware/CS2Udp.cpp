@@ -55,6 +55,7 @@ namespace Hardware
 
 	CS2Udp::~CS2Udp()
 	{
+		StopFrameSender();
 		receiverConnection.Terminate();
 		logger->Info(Languages::TextTerminatingSenderSocket);
 	}
@@ -56,6 +56,11 @@ namespace Hardware
 		Init();
 	}
 
+	CcSchnitte::~CcSchnitte()
+	{
+		StopFrameSender();
+	}
+
 	void CcSchnitte::Send(const unsigned char* buffer)
 	{
 		if (!serialLine.IsConnected())
@@ -31,6 +31,7 @@ namespace Hardware
 	{
 		public:
 			CcSchnitte(HardwareParams* const params);
+			~CcSchnitte();
 
 			static void GetArgumentTypesAndHint(std::map<unsigned char,ArgumentType>& argumentTypes, std::string& hint)
 			{
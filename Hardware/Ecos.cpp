@@ -54,6 +54,11 @@ namespace Hardware
 		logger(Logger::Logger::GetLogger("ECoS " + params->GetName() + " " + params->GetArg1())),
 	 	run(false),
 	 	tcp(Network::TcpClient::GetTcpClientConnection(logger, params->GetArg1(), EcosPort)),
+		receiveBufferStart(0),
+		receiveBufferEnd(0),
+		receiveCalls(0),
+		linesReceived(0),
+		readBuffer(receiveBuffer),
 	 	readBufferLength(0),
 		readBufferPosition(0)
 	{
@@ -158,42 +163,82 @@ namespace Hardware
 			Parser();
 		}
 		tcp.Terminate();
+		logger->Info(Languages::TextEcosReceiveStatistics, linesReceived, receiveCalls);
 		logger->Info(Languages::TextTerminatingReceiverThread);
 	}
 
 	void Ecos::ReadLine()
 	{
 		readBufferPosition = 0;
-		readBufferLength = -1;
-		while(true)
+		readBufferLength = 0;
+		while (true)
 		{
-			int dataLength = tcp.Receive(readBuffer + readBufferPosition, 1);
-			if (dataLength != 1)
+			char* const start = receiveBuffer + receiveBufferStart;
+			const size_t available = receiveBufferEnd - receiveBufferStart;
+			char* const end = static_cast<char*>(memchr(start, '\n', available));
+			if (end != nullptr)
 			{
-				readBufferLength = 0;
+				receiveBufferStart += end - start + 1;
+				const size_t length = RemoveCarriageReturns(start, end - start);
+				if (length == 0)
+				{
+					// an empty line is not an error, it just carries nothing to parse
+					continue;
+				}
+				start[length] = '\n';
+				readBuffer = start;
+				readBufferLength = length;
 				break;
 			}
-			if (readBuffer[readBufferPosition] == '\r')
+
+			if (available >= MaxMessageSize)
 			{
+				logger->Error(Languages::TextInvalidDataReceived);
+				receiveBufferStart = receiveBufferEnd;
 				continue;
 			}
-			if (readBuffer[readBufferPosition] == '\n')
+
+			// move the partial line to the front only if there is not enough space left behind it
+			if (available == 0)
 			{
-				readBufferLength = readBufferPosition;
-				break;
+				receiveBufferStart = 0;
+				receiveBufferEnd = 0;
 			}
-			++readBufferPosition;
-			if (readBufferPosition >= MaxMessageSize)
+			else if (ReceiveBufferSize - receiveBufferEnd < MaxMessageSize)
 			{
-				break;
+				memmove(receiveBuffer, start, available);
+				receiveBufferStart = 0;
+				receiveBufferEnd = available;
+			}
+
+			int dataLength = tcp.Receive(receiveBuffer + receiveBufferEnd, ReceiveBufferSize - receiveBufferEnd);
+			++receiveCalls;
+			if (dataLength <= 0)
+			{
+				readBuffer = receiveBuffer + receiveBufferStart;
+				return;
 			}
+			receiveBufferEnd += dataLength;
 		}
-		readBufferPosition = 0;
-		if (readBufferLength == 0)
+		++linesReceived;
+		logger->Hex(reinterpret_cast<unsigned char*>(readBuffer), readBufferLength);
+	}
+
+	size_t Ecos::RemoveCarriageReturns(char* line, const size_t length)
+	{
+		char* out = static_cast<char*>(memchr(line, '\r', length));
+		if (out == nullptr)
 		{
-			return;
+			return length;
 		}
-		logger->Hex(reinterpret_cast<unsigned char*>(readBuffer), readBufferLength);
+		for (char* in = out + 1; in < line + length; ++in)
+		{
+			if (*in != '\r')
+			{
+				*out++ = *in;
+			}
+		}
+		return out - line;
 	}
 
 	void Ecos::Parser()
@@ -88,11 +88,15 @@ namespace Hardware
 
 		private:
 			static const unsigned short MaxMessageSize = 1024;
+			// a received line is parsed in place, so the buffer holds several lines and one partial line
+			static const unsigned short ReceiveBufferSize = 8 * MaxMessageSize;
 			static const unsigned short EcosPort = 15471;
 
 			void Send(const char* data);
 			void Receiver();
 			void ReadLine();
+			// removes all \r within the line, returns the new length
+			static size_t RemoveCarriageReturns(char* line, const size_t length);
 			void Parser();
 			void ParseReply();
 			void ParseQueryLocos();
@@ -152,7 +156,7 @@ namespace Hardware
 			char GetChar(const size_t offset = 0) const
 			{
 				size_t position = readBufferPosition + offset;
-				if (position >= MaxMessageSize)
+				if (position > readBufferLength)
 				{
 					return 0;
 				}
@@ -161,7 +165,7 @@ namespace Hardware
 
 			char ReadAndConsumeChar()
 			{
-				if (readBufferPosition >= MaxMessageSize)
+				if (readBufferPosition > readBufferLength)
 				{
 					return 0;
 				}
@@ -170,7 +174,7 @@ namespace Hardware
 
 			bool CheckAndConsumeChar(const char charToCheck)
 			{
-				if (readBufferPosition >= MaxMessageSize)
+				if (readBufferPosition > readBufferLength)
 				{
 					return false;
 				}
@@ -179,7 +183,7 @@ namespace Hardware
 
 			bool CheckChar(const char charToCheck)
 			{
-				if (readBufferPosition >= MaxMessageSize)
+				if (readBufferPosition > readBufferLength)
 				{
 					return false;
 				}
@@ -210,8 +214,15 @@ namespace Hardware
 
 			Network::TcpConnection tcp;
 
-			char readBuffer[MaxMessageSize];
-			ssize_t readBufferLength;
+			char receiveBuffer[ReceiveBufferSize];
+			size_t receiveBufferStart;
+			size_t receiveBufferEnd;
+			unsigned int receiveCalls;
+			unsigned int linesReceived;
+
+			// current line within receiveBuffer, readBuffer[readBufferLength] is the \n
+			char* readBuffer;
+			size_t readBufferLength;
 			size_t readBufferPosition;
 
 			static const unsigned int MaxFeedbackModules = 128;
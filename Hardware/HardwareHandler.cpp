@@ -178,6 +178,10 @@ namespace Hardware
 		{
 			instance = createHardware(params);
 		}
+		if (instance != nullptr)
+		{
+			accessoryPulseScheduler = new AccessoryPulseScheduler(instance);
+		}
 	}
 
 	void HardwareHandler::Close()
@@ -185,6 +189,9 @@ namespace Hardware
 		Hardware::HardwareInterface* instanceTemp = instance;
 		instance = nullptr;
 		createHardware = nullptr;
+		// switches off the active pulses, so it has to be deleted before the hardware
+		delete accessoryPulseScheduler;
+		accessoryPulseScheduler = nullptr;
 		if (instanceTemp != nullptr)
 		{
 			destroyHardware(instanceTemp);
@@ -333,7 +340,7 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Accessory(accessory->GetProtocol(), accessory->GetAddress(), accessory->GetInvertedAccessoryState(), accessory->GetAccessoryPulseDuration());
+		accessoryPulseScheduler->Pulse(accessory->GetProtocol(), accessory->GetAddress(), accessory->GetInvertedAccessoryState(), accessory->GetAccessoryPulseDuration());
 	}
 
 	void HardwareHandler::SwitchState(const ControlType controlType, const DataModel::Switch* mySwitch)
@@ -351,21 +358,23 @@ namespace Hardware
 		DataModel::AccessoryPulseDuration duration = mySwitch->GetAccessoryPulseDuration();
 		if (mySwitch->GetType() == DataModel::SwitchTypeThreeWay)
 		{
+			// the second drive must not be energised before the first one is off again
+			AccessoryPulseScheduler::Sequence first;
 			switch (mySwitch->GetAccessoryState())
 			{
 				case DataModel::SwitchStateTurnout:
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					first = accessoryPulseScheduler->Pulse(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					accessoryPulseScheduler->Pulse(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration, first);
 					break;
 
 				case DataModel::SwitchStateStraight:
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration);
+					first = accessoryPulseScheduler->Pulse(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					accessoryPulseScheduler->Pulse(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOff), duration, first);
 					break;
 
 				case DataModel::SwitchStateThird:
-					instance->Accessory(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
-					instance->Accessory(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					first = accessoryPulseScheduler->Pulse(protocol, address, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration);
+					accessoryPulseScheduler->Pulse(protocol, address + 1, mySwitch->CalculateInvertedAccessoryState(DataModel::AccessoryStateOn), duration, first);
 					break;
 
 				default:
@@ -374,7 +383,7 @@ namespace Hardware
 			return;
 		}
 		// else left or right switch
-		instance->Accessory(protocol, address, mySwitch->GetInvertedAccessoryState(), duration);
+		accessoryPulseScheduler->Pulse(protocol, address, mySwitch->GetInvertedAccessoryState(), duration);
 	}
 
 	void HardwareHandler::SignalState(const ControlType controlType, const DataModel::Signal* signal)
@@ -386,7 +395,16 @@ namespace Hardware
 		{
 			return;
 		}
-		instance->Accessory(signal->GetProtocol(), signal->GetAddress(), signal->GetInvertedAccessoryState(), signal->GetAccessoryPulseDuration());
+		accessoryPulseScheduler->Pulse(signal->GetProtocol(), signal->GetAddress(), signal->GetInvertedAccessoryState(), signal->GetAccessoryPulseDuration());
+	}
+
+	void HardwareHandler::WaitUntilAccessoryPulseDone(const Protocol protocol, const Address address)
+	{
+		if (accessoryPulseScheduler == nullptr)
+		{
+			return;
+		}
+		accessoryPulseScheduler->WaitUntilIdle(protocol, address);
 	}
 
 	bool HardwareHandler::ProgramCheckValues(const ProgramMode mode, const CvNumber cv, const CvValue value)
@@ -25,6 +25,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "ControlInterface.h"
 #include "DataModel/LocoFunctions.h"
 #include "DataTypes.h"
+#include "Hardware/AccessoryPulseScheduler.h"
 #include "Hardware/HardwareInterface.h"
 #include "Hardware/HardwareParams.h"
 #include "Manager.h"
@@ -51,6 +52,7 @@ namespace Hardware
 				createHardware(nullptr),
 				destroyHardware(nullptr),
 				instance(nullptr),
+				accessoryPulseScheduler(nullptr),
 				params(nullptr)
 			{
 				Init(params);
@@ -96,6 +98,7 @@ namespace Hardware
 			void SignalState(const ControlType controlType, const DataModel::Signal* signal) override;
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
+			void WaitUntilAccessoryPulseDone(const Protocol protocol, const Address address) override;
 
 			static void ArgumentTypesOfHardwareTypeAndHint(const HardwareType hardwareType, std::map<unsigned char,ArgumentType>& arguments, std::string& hint);
 
@@ -106,6 +109,7 @@ namespace Hardware
 			createHardware_t* createHardware;
 			destroyHardware_t* destroyHardware;
 			Hardware::HardwareInterface* instance;
+			AccessoryPulseScheduler* accessoryPulseScheduler;
 			const HardwareParams* params;
 
 			static const std::string hardwareSymbols[];
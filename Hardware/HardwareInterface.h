@@ -99,12 +99,11 @@ namespace Hardware
 				}
 			}
 
-			// accessory command
-			virtual void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
-			{
-				AccessoryOnOrOff(protocol, address, state, true);
-				std::async(std::launch::async, AccessoryOnOrOffStatic, this, protocol, address, state, duration);
-			};
+			// maximum number of accessory outputs that may be on at the same time, the pulses are handled by the AccessoryPulseScheduler
+			virtual size_t GetMaxActiveAccessoryPulses() const { return DefaultMaxActiveAccessoryPulses; }
+
+			// minimum time in ms between two accessory commands, slow buses need a gap to not lose commands
+			virtual unsigned int GetAccessoryCommandGap() const { return 0; }
 
 			// read CV value
 			virtual void ProgramRead(__attribute__((unused)) const ProgramMode mode, __attribute__((unused)) const Address address, __attribute__((unused)) const CvNumber cv) {}
@@ -117,14 +116,12 @@ namespace Hardware
 			const ControlID controlID;
 			const std::string name;
 
+			static const size_t DefaultMaxActiveAccessoryPulses = 4;
+
 			virtual void AccessoryOnOrOff(__attribute__((unused)) const Protocol protocol, __attribute__((unused)) const Address address, __attribute__((unused)) const DataModel::AccessoryState state, __attribute__((unused)) const bool on) {}
 
 		private:
-			static void AccessoryOnOrOffStatic(HardwareInterface* hardware, const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
-			{
-				Utils::Utils::SleepForMilliseconds(duration);
-				hardware->AccessoryOnOrOff(protocol, address, state, false);
-			}
+			friend class AccessoryPulseScheduler;
 	};
 
 } // namespace
@@ -0,0 +1,113 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "DataTypes.h"
+
+namespace Hardware
+{
+	// Table of per loco states of a command station indexed directly by the loco address. It covers
+	// the whole 14 bit address range of DCC and MM, so a lookup is a single array access without
+	// allocation. Every modified entry is marked dirty until the command station has confirmed it.
+	template<class Entry>
+	class LocoAddressTable
+	{
+		public:
+			static const Address MaxAddress = 0x3FFF;
+
+			LocoAddressTable()
+			:	entries(static_cast<size_t>(MaxAddress) + 1),
+				none()
+			{
+				for (auto& word : dirty)
+				{
+					word = 0;
+				}
+			}
+
+			LocoAddressTable(const LocoAddressTable&) = delete;
+			LocoAddressTable& operator=(const LocoAddressTable&) = delete;
+
+			// returns a default entry for addresses out of range
+			inline const Entry& Get(const Address address) const
+			{
+				return address > MaxAddress ? none : entries[address];
+			}
+
+			// returns nullptr for addresses out of range
+			inline Entry* Modify(const Address address)
+			{
+				if (address > MaxAddress)
+				{
+					return nullptr;
+				}
+				dirty[address / BitsPerWord] |= Bit(address);
+				return &entries[address];
+			}
+
+			inline bool IsDirty(const Address address) const
+			{
+				return address <= MaxAddress && (dirty[address / BitsPerWord] & Bit(address));
+			}
+
+			inline void ClearDirty(const Address address)
+			{
+				if (address > MaxAddress)
+				{
+					return;
+				}
+				dirty[address / BitsPerWord] &= ~Bit(address);
+			}
+
+			void GetDirty(std::vector<Address>& addresses) const
+			{
+				for (size_t word = 0; word < Words; ++word)
+				{
+					uint64_t bits = dirty[word];
+					for (Address bit = 0; bits != 0; ++bit, bits >>= 1)
+					{
+						if (bits & 1)
+						{
+							addresses.push_back(static_cast<Address>(word * BitsPerWord + bit));
+						}
+					}
+				}
+			}
+
+		private:
+			static const size_t BitsPerWord = 64;
+			static const size_t Words = (static_cast<size_t>(MaxAddress) + BitsPerWord) / BitsPerWord;
+
+			static inline uint64_t Bit(const Address address)
+			{
+				return static_cast<uint64_t>(1) << (address % BitsPerWord);
+			}
+
+			std::vector<Entry> entries;
+			const Entry none;
+			// the receiver thread and the callers of the driver modify entries concurrently
+			std::atomic<uint64_t> dirty[Words];
+	};
+} // namespace Hardware
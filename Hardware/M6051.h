@@ -68,6 +68,9 @@ namespace Hardware
 
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 
+			// the 6050 interface has no command buffer, the gap is configured in railcontrol.conf
+			unsigned int GetAccessoryCommandGap() const override { return manager->GetM6051CommandGap(); }
+
 		private:
 			Logger::Logger* logger;
 			static const unsigned char MaxS88Modules = 62;
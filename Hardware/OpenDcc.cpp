@@ -243,7 +243,7 @@ namespace Hardware
 
 	bool OpenDcc::SendXLok(const Address address) const
 	{
-		OpenDccCacheEntry entry = cache.GetData(address);
+		const OpenDccCacheEntry& entry = cache.GetData(address);
 		logger->Info(Languages::TextSettingSpeedOrientationLight, address, entry.speed, Languages::GetLeftRight(static_cast<Orientation>((entry.orientationF0 >> 5) & 0x01)), Languages::GetOnOff((entry.orientationF0 >> 4) & 0x01));
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
@@ -282,7 +282,7 @@ namespace Hardware
 
 	bool OpenDcc::SendXFunc(const Address address) const
 	{
-		OpenDccCacheEntry entry = cache.GetData(address);
+		const OpenDccCacheEntry& entry = cache.GetData(address);
 		logger->Info(Languages::TextSettingFunctions1_8, address, entry.function[0]);
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
@@ -293,7 +293,7 @@ namespace Hardware
 
 	bool OpenDcc::SendXFunc2(const Address address) const
 	{
-		OpenDccCacheEntry entry = cache.GetData(address);
+		const OpenDccCacheEntry& entry = cache.GetData(address);
 		logger->Info(Languages::TextSettingFunctions9_16, address, entry.function[1]);
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
@@ -304,7 +304,7 @@ namespace Hardware
 
 	bool OpenDcc::SendXFunc34(const Address address) const
 	{
-		OpenDccCacheEntry entry = cache.GetData(address);
+		const OpenDccCacheEntry& entry = cache.GetData(address);
 		logger->Info(Languages::TextSettingFunctions17_28, address, entry.function[2], entry.function[3]);
 		const unsigned char addressLSB = (address & 0xFF);
 		const unsigned char addressMSB = (address >> 8);
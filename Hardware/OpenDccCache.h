@@ -20,6 +20,9 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include "DataTypes.h"
+#include "Hardware/LocoAddressTable.h"
+
 namespace Hardware
 {
 	class OpenDccCacheEntry
@@ -48,32 +51,36 @@ namespace Hardware
 
 			void SetSpeed(const Address address, const Speed speed)
 			{
-				OpenDccCacheEntry entry = GetData(address);
+				OpenDccCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
+				{
+					return;
+				}
 
 				if (speed == 0)
 				{
-					entry.speed = 0;
+					entry->speed = 0;
 				}
 				else if (speed > 1000)
 				{
-					entry.speed = 127;
+					entry->speed = 127;
 				}
 				else
 				{
-					entry.speed = (speed >> 3) + 2;
+					entry->speed = (speed >> 3) + 2;
 				}
-
-				cache[address] = entry;
 			}
 
 			void SetOrientation(const Address address, const Orientation orientation)
 			{
-				OpenDccCacheEntry entry = GetData(address);
-
-				entry.orientationF0 &= ~(1 << 5);
-				entry.orientationF0 |= static_cast<unsigned char>(orientation) << 5;
+				OpenDccCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
+				{
+					return;
+				}
 
-				cache[address] = entry;
+				entry->orientationF0 &= ~(1 << 5);
+				entry->orientationF0 |= static_cast<unsigned char>(orientation) << 5;
 			}
 
 			void SetFunction(const Address address,
@@ -81,36 +88,31 @@ namespace Hardware
 				const DataModel::LocoFunctionState on)
 			{
 				bool onInternal = static_cast<bool>(on);
-				OpenDccCacheEntry entry = GetData(address);
+				OpenDccCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
+				{
+					return;
+				}
 
 				if (function == 0)
 				{
-					entry.orientationF0 &= ~(1 << 4);
-					entry.orientationF0 |= static_cast<unsigned char>(onInternal) << 4;
+					entry->orientationF0 &= ~(1 << 4);
+					entry->orientationF0 |= static_cast<unsigned char>(onInternal) << 4;
 				}
 				else
 				{
 					unsigned char shift = function - 1;
-					entry.functions &= ~(1 << shift);
-					entry.functions |= static_cast<uint32_t>(onInternal) << shift;
+					entry->functions &= ~(1 << shift);
+					entry->functions |= static_cast<uint32_t>(onInternal) << shift;
 				}
-
-				cache[address] = entry;
 			}
 
-			OpenDccCacheEntry GetData(const Address address) const
+			inline const OpenDccCacheEntry& GetData(const Address address) const
 			{
-				if (cache.count(address) == 0)
-				{
-					OpenDccCacheEntry entry;
-					return entry;
-				}
-
-				return cache.at(address);
+				return cache.Get(address);
 			}
 
 		private:
-			std::map<Address, OpenDccCacheEntry> cache;
+			LocoAddressTable<OpenDccCacheEntry> cache;
 	};
 } // namespace
-
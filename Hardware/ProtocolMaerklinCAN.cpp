@@ -18,6 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <cstring>
 #include <deque>
 
 #include "Hardware/ProtocolMaerklinCAN.h"
@@ -37,6 +38,7 @@ namespace Hardware
 
 	ProtocolMaerklinCAN::~ProtocolMaerklinCAN()
 	{
+		StopFrameSender();
 		if (canFileData != nullptr)
 		{
 			free(canFileData);
@@ -51,6 +53,128 @@ namespace Hardware
 		cs2MasterThread.join();
 	}
 
+	void ProtocolMaerklinCAN::StopFrameSender()
+	{
+		if (frameSenderThread.joinable() == false)
+		{
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> guard(frameMutex);
+			frameSenderRun = false;
+			frameCondition.notify_all();
+		}
+		frameSenderThread.join();
+		logger->Info(Languages::TextCanFrameStatistics, framesSent, maxQueuedFrames);
+	}
+
+	void ProtocolMaerklinCAN::SendInternal(const unsigned char* buffer)
+	{
+		Frame frame;
+		memcpy(frame.data, buffer, CANCommandBufferLength);
+		const CanCommand command = ParseCommand(buffer);
+		std::lock_guard<std::mutex> guard(frameMutex);
+		if (command == CanCommandSystem)
+		{
+			// booster stop and go overtake all other frames but keep their own order
+			auto position = frameQueue.begin();
+			while (position != frameQueue.end() && ParseCommand(position->data) == CanCommandSystem)
+			{
+				++position;
+			}
+			frameQueue.insert(position, frame);
+		}
+		else if (ReplaceQueuedLocoFrame(command, frame))
+		{
+			return;
+		}
+		// a frame that can not be replaced by a newer one is never dropped
+		else if (frameQueue.size() >= MaxQueuedFrames && (command == CanCommandLocoSpeed || command == CanCommandLocoDirection))
+		{
+			logger->Warning(Languages::TextCanFrameQueueFull);
+			return;
+		}
+		else
+		{
+			frameQueue.push_back(frame);
+		}
+		if (frameQueue.size() > maxQueuedFrames)
+		{
+			maxQueuedFrames = frameQueue.size();
+		}
+		frameCondition.notify_one();
+	}
+
+	bool ProtocolMaerklinCAN::ReplaceQueuedLocoFrame(const CanCommand command, const Frame& frame)
+	{
+		if (command != CanCommandLocoSpeed && command != CanCommandLocoDirection)
+		{
+			return false;
+		}
+		// only the latest frame of the loco may be replaced, otherwise the order would change
+		for (auto position = frameQueue.rbegin(); position != frameQueue.rend(); ++position)
+		{
+			const CanCommand queuedCommand = ParseCommand(position->data);
+			if (queuedCommand == CanCommandSystem || memcmp(position->data + 5, frame.data + 5, 4) != 0)
+			{
+				continue;
+			}
+			if (queuedCommand != command)
+			{
+				return false;
+			}
+			*position = frame;
+			return true;
+		}
+		return false;
+	}
+
+	void ProtocolMaerklinCAN::FrameSender()
+	{
+		Utils::Utils::SetThreadName("CAN Frame Sender");
+		std::unique_lock<std::mutex> lock(frameMutex);
+		// frames queued before stopping are still sent, e.g. booster off
+		while (frameSenderRun || frameQueue.empty() == false)
+		{
+			if (frameQueue.empty())
+			{
+				frameCondition.wait(lock);
+				continue;
+			}
+			RefillFrameTokens(std::chrono::steady_clock::now());
+			if (frameTokens == 0)
+			{
+				frameCondition.wait_until(lock, frameTokensRefill + FrameInterval());
+				continue;
+			}
+			--frameTokens;
+			Frame frame = frameQueue.front();
+			frameQueue.pop_front();
+			lock.unlock();
+			logger->Hex(frame.data, 5 + ParseLength(frame.data));
+			Send(frame.data);
+			++framesSent;
+			lock.lock();
+		}
+	}
+
+	void ProtocolMaerklinCAN::RefillFrameTokens(const std::chrono::steady_clock::time_point& now)
+	{
+		const auto newTokens = (now - frameTokensRefill) / FrameInterval();
+		if (newTokens <= 0)
+		{
+			return;
+		}
+		frameTokens += static_cast<unsigned int>(newTokens);
+		frameTokensRefill += FrameInterval() * newTokens;
+		if (frameTokens >= static_cast<unsigned int>(FrameBurst))
+		{
+			// a full bucket does not save up tokens while idle
+			frameTokens = FrameBurst;
+			frameTokensRefill = now;
+		}
+	}
+
 	void ProtocolMaerklinCAN::Wait(const unsigned int duration) const
 	{
 		unsigned int wait = duration;
@@ -219,6 +343,20 @@ namespace Hardware
 		SendInternal(buffer);
 	}
 
+	void ProtocolMaerklinCAN::LocoSpeedOrientationFunctions(const Protocol protocol,
+		const Address address,
+		const Speed speed,
+		const Orientation orientation,
+		std::vector<DataModel::LocoFunctionEntry>& functions)
+	{
+		LocoSpeed(protocol, address, speed);
+		LocoOrientation(protocol, address, orientation);
+		for (const DataModel::LocoFunctionEntry& functionEntry : functions)
+		{
+			LocoFunction(protocol, address, functionEntry.nr, functionEntry.state);
+		}
+	}
+
 	void ProtocolMaerklinCAN::AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on)
 	{
 		unsigned char buffer[CANCommandBufferLength];
@@ -20,6 +20,12 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "DataModel/AccessoryBase.h"
 #include "DataModel/LocoFunctions.h"
 #include "Hardware/Capabilities.h"
@@ -84,6 +90,13 @@ namespace Hardware
 				const DataModel::LocoFunctionNr function,
 				const DataModel::LocoFunctionState on) override;
 
+			// the frame sender spaces the frames, so no sleeps are needed here
+			void LocoSpeedOrientationFunctions(const Protocol protocol,
+				const Address address,
+				const Speed speed,
+				const Orientation orientation,
+				std::vector<DataModel::LocoFunctionEntry>& functions) override;
+
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
@@ -99,7 +112,12 @@ namespace Hardware
 				hasCs2Master(false),
 				canFileDataSize(0),
 				canFileData(nullptr),
-				canFileDataPointer(nullptr)
+				canFileDataPointer(nullptr),
+				frameSenderRun(true),
+				frameTokens(FrameBurst),
+				frameTokensRefill(std::chrono::steady_clock::now()),
+				framesSent(0),
+				maxQueuedFrames(0)
 			{
 				if (uid == 0)
 				{
@@ -110,10 +128,14 @@ namespace Hardware
 					hash = CalcHash(uid);
 					logger->Debug(Languages::TextMyUidHash, params->GetArg5(), Utils::Utils::IntegerToHex(hash));
 				}
+				frameSenderThread = std::thread(&ProtocolMaerklinCAN::FrameSender, this);
 			}
 
 			void Init();
 
+			// has to be called in the destructor of the derived class while Send() is still usable
+			void StopFrameSender();
+
 			virtual ~ProtocolMaerklinCAN();
 
 			void Parse(const unsigned char* buffer);
@@ -367,11 +389,8 @@ namespace Hardware
 			void Wait(const unsigned int duration) const;
 			void Cs2MasterThread();
 
-			inline void SendInternal(const unsigned char* buffer)
-			{
-				logger->Hex(buffer, 5 + ParseLength(buffer));
-				Send(buffer);
-			}
+			// queues the frame for the frame sender, never blocks the caller
+			void SendInternal(const unsigned char* buffer);
 			virtual void Send(const unsigned char* buffer) = 0;
 
 			static inline LocoFunctionCs2Icon CalculateCs2Icon(const DataModel::LocoFunctionNr nr,
@@ -399,6 +418,40 @@ namespace Hardware
 
 			LocoCache locoCache;
 
+			// Token bucket for outgoing frames: the Gleisbox loses frames if they arrive faster
+			// than FramesPerSecond. Up to FrameBurst frames are sent back to back after a pause.
+			static const unsigned int FramesPerSecond = 40;
+			static const unsigned int FrameBurst = 4;
+
+			static inline std::chrono::microseconds FrameInterval()
+			{
+				return std::chrono::microseconds(1000000 / FramesPerSecond);
+			}
+
+			struct Frame
+			{
+				unsigned char data[CANCommandBufferLength];
+			};
+
+			// above this size loco speed and direction frames that can not replace a queued one are dropped
+			static const size_t MaxQueuedFrames = 256;
+
+			// frameMutex must be locked when calling this function
+			bool ReplaceQueuedLocoFrame(const CanCommand command, const Frame& frame);
+			void FrameSender();
+			// frameMutex must be locked when calling this function
+			void RefillFrameTokens(const std::chrono::steady_clock::time_point& now);
+
+			std::thread frameSenderThread;
+			std::mutex frameMutex;
+			std::condition_variable frameCondition;
+			std::deque<Frame> frameQueue;
+			bool frameSenderRun;
+			unsigned int frameTokens;
+			std::chrono::steady_clock::time_point frameTokensRefill;
+			unsigned int framesSent;
+			size_t maxQueuedFrames;
+
 			static const uint8_t MaxNrOfCs2FunctionIcons = 128;
 			static const DataModel::LocoFunctionIcon LocoFunctionMapCs2ToRailControl[MaxNrOfCs2FunctionIcons];
 			static const ProtocolMaerklinCAN::LocoFunctionCs2Icon LocoFunctionMapRailControlToCs2[DataModel::MaxLocoFunctionIcons];
@@ -50,7 +50,12 @@ namespace Hardware
 	 	run(true),
 	 	connection(logger, params->GetArg1(), Z21Port),
 	 	lastProgramMode(ProgramModeMm),
-	 	connected(false)
+	 	connected(false),
+	 	batchWindow(manager->GetZ21BatchWindow()),
+	 	batchLength(0),
+	 	batchCommands(0),
+	 	commandsSent(0),
+	 	datagramsSent(0)
 	{
 		logger->Info(Languages::TextStarting, name);
 
@@ -62,18 +67,28 @@ namespace Hardware
 		{
 			logger->Error(Languages::TextUnableToCreateUdpSocket, params->GetArg1(), Z21Port);
 		}
+		if (batchWindow.count() > 0)
+		{
+			batchSenderThread = std::thread(&Hardware::Z21::BatchSender, this);
+		}
 		receiverThread = std::thread(&Hardware::Z21::Receiver, this);
 		heartBeatThread = std::thread(&Hardware::Z21::HeartBeatSender, this);
-		accessorySenderThread = std::thread(&Hardware::Z21::AccessorySender, this);
 	}
 
 	Z21::~Z21()
 	{
 		run = false;
+		if (batchSenderThread.joinable())
+		{
+			{
+				std::lock_guard<std::mutex> guard(batchMutex);
+				batchCondition.notify_all();
+			}
+			batchSenderThread.join();
+			logger->Info(Languages::TextZ21BatchStatistics, commandsSent, datagramsSent, commandsSent - datagramsSent);
+		}
 		SendLogOff();
-		accessoryQueue.Terminate();
 		connection.Terminate();
-		accessorySenderThread.join();
 		heartBeatThread.join();
 		receiverThread.join();
 		logger->Info(Languages::TextTerminatingSenderSocket);
@@ -277,28 +292,16 @@ namespace Hardware
 		}
 	}
 
-	void Z21::Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
+	void Z21::AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on)
 	{
 		if (!AccessoryProtocolSupported(protocol))
 		{
 			return;
 		}
-		AccessoryQueueEntry entry(protocol, address, state, duration);
-		accessoryQueue.Enqueue(entry);
-	}
-
-	void Z21::AccessoryOn(const Protocol protocol, const Address address, const DataModel::AccessoryState state)
-	{
-		AccessoryOnOrOff(protocol, address, state, true);
-	}
-
-	void Z21::AccessoryOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state)
-	{
-		AccessoryOnOrOff(protocol, address, state, false);
-	}
-
-	void Z21::AccessoryOnOrOff(__attribute__((unused)) const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on)
-	{
+		if (on)
+		{
+			SendSetTurnoutMode(address, protocol);
+		}
 		const Address zeroBasedAddress = address - 1;
 		unsigned char buffer[9] = { 0x09, 0x00, 0x40, 0x00, 0x53 };
 		Utils::Utils::ShortToDataBigEndian(zeroBasedAddress, buffer + 5);
@@ -307,26 +310,6 @@ namespace Hardware
 		Send(buffer, sizeof(buffer));
 	}
 
-	void Z21::AccessorySender()
-	{
-		Utils::Utils::SetThreadName("Z21 Accessory Sender");
-		logger->Info(Languages::TextAccessorySenderThreadStarted);
-		while (run)
-		{
-			AccessoryQueueEntry entry = accessoryQueue.Dequeue();
-			if (entry.protocol == ProtocolNone)
-			{
-				// ProtocolNone is in queue when we should quit
-				continue;
-			}
-			SendSetTurnoutMode(entry.address, entry.protocol);
-			AccessoryOn(entry.protocol, entry.address, entry.state);
-			Utils::Utils::SleepForMilliseconds(entry.duration);
-			AccessoryOff(entry.protocol, entry.address, entry.state);
-		}
-		logger->Info(Languages::TextTerminatingAccessorySenderThread);
-	}
-
 	void Z21::ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv)
 	{
 		switch (mode)
@@ -445,6 +428,7 @@ namespace Hardware
 		logger->Info(Languages::TextHeartBeatThreadStarted);
 		const unsigned int counterMask = 0x07;
 		unsigned int counter = counterMask;
+		bool connectionLost = false;
 		while(run)
 		{
 			Utils::Utils::SleepForSeconds(1);
@@ -456,10 +440,16 @@ namespace Hardware
 			}
 			if (connected)
 			{
+				if (connectionLost)
+				{
+					connectionLost = false;
+					ResynchronizeLocos();
+				}
 				connected = false;
 			}
 			else
 			{
+				connectionLost = true;
 				StartUpConnection();
 			}
 			SendGetStatus();
@@ -467,6 +457,31 @@ namespace Hardware
 		logger->Info(Languages::TextTerminatingHeartBeatThread);
 	}
 
+	void Z21::ResynchronizeLocos()
+	{
+		// commands sent while the connection was lost did not reach the Z21
+		std::vector<Address> addresses;
+		locoCache.GetUnsynchronized(addresses);
+		if (addresses.empty())
+		{
+			return;
+		}
+		logger->Info(Languages::TextResynchronizingLocos, addresses.size());
+		for (auto address : addresses)
+		{
+			const Z21LocoCacheEntry entry = locoCache.GetData(address);
+			if (entry.protocol == ProtocolNone)
+			{
+				continue;
+			}
+			LocoSpeedOrientation(entry.protocol, address, entry.speed, entry.orientation);
+			for (DataModel::LocoFunctionNr function = 0; function <= 28; ++function)
+			{
+				LocoFunction(entry.protocol, address, function, (entry.functions >> function) & 0x01 ? DataModel::LocoFunctionStateOn : DataModel::LocoFunctionStateOff);
+			}
+		}
+	}
+
 	void Z21::Receiver()
 	{
 		Utils::Utils::SetThreadName("Z21 Receiver");
@@ -854,6 +869,7 @@ namespace Hardware
 		const uint32_t newFunctions = f0 | f1_4 | f5_12 | f13_20 | f21_28;
 		if (newFunctions == oldFunctions)
 		{
+			locoCache.Synchronized(address);
 			return;
 		}
 		const uint32_t functionsDiff = newFunctions ^ oldFunctions;
@@ -868,6 +884,7 @@ namespace Hardware
 			locoCache.SetFunction(address, function, newState);
 			manager->LocoFunctionState(ControlTypeHardware, controlID, protocol, address, function, newState);
 		}
+		locoCache.Synchronized(address);
 	}
 
 	void Z21::ParseCvData(const unsigned char* buffer)
@@ -1110,6 +1127,59 @@ namespace Hardware
 	int Z21::Send(const unsigned char* buffer, const size_t bufferLength)
 	{
 		logger->Hex(buffer, bufferLength);
-		return connection.Send(buffer, bufferLength);
+		if (batchWindow.count() == 0 || run == false)
+		{
+			return connection.Send(buffer, bufferLength);
+		}
+
+		// the Z21 accepts several commands concatenated in one datagram
+		std::lock_guard<std::mutex> guard(batchMutex);
+		if (batchLength + bufferLength > Z21CommandBufferLength)
+		{
+			BatchFlush();
+		}
+		memcpy(batchBuffer + batchLength, buffer, bufferLength);
+		batchLength += bufferLength;
+		++batchCommands;
+		if (batchCommands == 1)
+		{
+			batchDeadline = std::chrono::steady_clock::now() + batchWindow;
+			batchCondition.notify_one();
+		}
+		return static_cast<int>(bufferLength);
+	}
+
+	void Z21::BatchSender()
+	{
+		Utils::Utils::SetThreadName("Z21 Batch Sender");
+		std::unique_lock<std::mutex> lock(batchMutex);
+		while (run)
+		{
+			if (batchLength == 0)
+			{
+				batchCondition.wait(lock);
+				continue;
+			}
+			if (std::chrono::steady_clock::now() < batchDeadline)
+			{
+				batchCondition.wait_until(lock, batchDeadline);
+				continue;
+			}
+			BatchFlush();
+		}
+		BatchFlush();
+	}
+
+	void Z21::BatchFlush()
+	{
+		if (batchLength == 0)
+		{
+			return;
+		}
+		connection.Send(batchBuffer, batchLength);
+		commandsSent += batchCommands;
+		++datagramsSent;
+		batchLength = 0;
+		batchCommands = 0;
 	}
 } // namespace
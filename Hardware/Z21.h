@@ -21,7 +21,10 @@ along with RailControl; see the file LICENCE. If not see
 #pragma once
 
 #include <arpa/inet.h>
+#include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -38,29 +41,6 @@ along with RailControl; see the file LICENCE. If not see
 
 namespace Hardware
 {
-	class AccessoryQueueEntry
-	{
-		public:
-			AccessoryQueueEntry()
-			:	protocol(ProtocolNone),
-			 	address(AddressNone),
-			 	state(DataModel::DefaultState),
-			 	duration(DataModel::DefaultAccessoryPulseDuration)
-			{}
-
-			AccessoryQueueEntry(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration)
-			:	protocol(protocol),
-			 	address(address),
-			 	state(state),
-			 	duration(duration)
-			{}
-
-			Protocol protocol;
-			Address address;
-			DataModel::AccessoryState state;
-			DataModel::AccessoryPulseDuration duration;
-	};
-
 	class Z21 : HardwareInterface
 	{
 		public:
@@ -132,7 +112,6 @@ namespace Hardware
 				const Orientation orientation,
 				std::vector<DataModel::LocoFunctionEntry>& functions) override;
 
-			void Accessory(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const DataModel::AccessoryPulseDuration duration) override;
 			void AccessoryOnOrOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state, const bool on) override;
 			void ProgramRead(const ProgramMode mode, const Address address, const CvNumber cv) override;
 			void ProgramWrite(const ProgramMode mode, const Address address, const CvNumber cv, const CvValue value) override;
@@ -240,14 +219,23 @@ namespace Hardware
 			Network::UdpConnection connection;
 			std::thread receiverThread;
 			std::thread heartBeatThread;
-			std::thread accessorySenderThread;
 			Z21LocoCache locoCache;
 			Z21TurnoutCache turnoutCache;
 			Z21FeedbackCache feedbackCache;
 			ProgramMode lastProgramMode;
 			volatile bool connected;
 
-			Utils::ThreadSafeQueue<AccessoryQueueEntry> accessoryQueue;
+			// commands sent within batchWindow are packed into one datagram by the batch sender
+			std::chrono::milliseconds batchWindow;
+			std::thread batchSenderThread;
+			std::mutex batchMutex;
+			std::condition_variable batchCondition;
+			unsigned char batchBuffer[Z21CommandBufferLength];
+			size_t batchLength;
+			unsigned int batchCommands;
+			std::chrono::steady_clock::time_point batchDeadline;
+			uint64_t commandsSent;
+			uint64_t datagramsSent;
 
 			void ProgramMm(const CvNumber cv, const CvValue value);
 			void ProgramDccRead(const CvNumber cv);
@@ -255,8 +243,10 @@ namespace Hardware
 			void ProgramDccPom(const PomDB0 db0, const PomOption option, const Address address, const CvNumber cv, const CvValue value = 0);
 
 			void LocoSpeedOrientation(const Protocol protocol, const Address address, const Speed speed, const Orientation orientation);
-			void AccessorySender();
 			void HeartBeatSender();
+			void BatchSender();
+			// batchMutex must be locked when calling this function
+			void BatchFlush();
 			void Receiver();
 			ssize_t ParseData(const unsigned char* buffer, size_t bufferLength);
 			void ParseXHeader(const unsigned char* buffer);
@@ -268,6 +258,7 @@ namespace Hardware
 			void ParseDetectorData(const unsigned char* buffer);
 
 			void StartUpConnection();
+			void ResynchronizeLocos();
 			void SendGetSerialNumber();
 			void SendGetHardwareInfo();
 			void SendGetStatus();
@@ -283,8 +274,6 @@ namespace Hardware
 			void SendSetTurnoutMode(const Address address, const Protocol protocol);
 			void SendSetTurnoutModeMM(const Address address);
 			void SendSetTurnoutModeDCC(const Address address);
-			void AccessoryOn(const Protocol protocol, const Address address, const DataModel::AccessoryState state);
-			void AccessoryOff(const Protocol protocol, const Address address, const DataModel::AccessoryState state);
 			int Send(const unsigned char* buffer, const size_t bufferLength);
 			int Send(const char* buffer, const size_t bufferLength) { return Send(reinterpret_cast<const unsigned char*>(buffer), bufferLength); }
 
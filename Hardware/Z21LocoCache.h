@@ -20,9 +20,10 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
-#include <map>
+#include <vector>
 
 #include "DataTypes.h"
+#include "Hardware/LocoAddressTable.h"
 
 namespace Hardware
 {
@@ -30,114 +31,116 @@ namespace Hardware
 	{
 		public:
 			Z21LocoCacheEntry()
-			:	speed(MinSpeed),
-			 	orientation(OrientationRight),
-			 	functions(0),
-			 	protocol(ProtocolNone)
+			:	functions(0),
+				speed(MinSpeed),
+				protocol(ProtocolNone),
+				orientation(OrientationRight)
 			{}
 
-			Z21LocoCacheEntry(const Speed speed, const Orientation orientation, const Protocol protocol)
-			:	speed(speed),
-			 	orientation(orientation),
-			 	functions(0),
-			 	protocol(protocol)
-			{}
-
-			Speed speed;
-			Orientation orientation;
 			uint32_t functions;
+			Speed speed;
 			Protocol protocol;
+			Orientation orientation;
 	};
 
 	class Z21LocoCache
 	{
 		public:
-			Z21LocoCacheEntry GetData(const Address address)
+			inline const Z21LocoCacheEntry& GetData(const Address address) const
 			{
-				if (cache.count(address) == 1)
+				return cache.Get(address);
+			}
+
+			inline void SetSpeed(const Address address, const Speed speed)
+			{
+				Z21LocoCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
 				{
-					return cache[address];
+					return;
 				}
-				Z21LocoCacheEntry entry;
-				return entry;
+				entry->speed = speed;
 			}
 
-			void SetSpeed(const Address address, const Speed speed)
+			inline Speed GetSpeed(const Address address) const
 			{
-				Z21LocoCacheEntry entry = GetData(address);
-				entry.speed = speed;
-				cache[address] = entry;
+				return cache.Get(address).speed;
 			}
 
-			Speed GetSpeed(const Address address)
+			inline void SetOrientation(const Address address, const Orientation orientation)
 			{
-				if (cache.count(address) == 0)
+				Z21LocoCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
 				{
-					return MinSpeed;
+					return;
 				}
-				return cache[address].speed;
+				entry->orientation = orientation;
 			}
 
-			void SetOrientation(const Address address, const Orientation orientation)
+			inline Orientation GetOrientation(const Address address) const
 			{
-				Z21LocoCacheEntry entry = GetData(address);
-				entry.orientation = orientation;
-				cache[address] = entry;
+				return cache.Get(address).orientation;
 			}
 
-			Orientation GetOrientation(const Address address)
+			inline void SetSpeedOrientationProtocol(const Address address, const Speed speed, const Orientation orientation, const Protocol protocol)
 			{
-				if (cache.count(address) == 0)
+				Z21LocoCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
 				{
-					return OrientationRight;
+					return;
 				}
-				return cache[address].orientation;
-			}
-
-			void SetSpeedOrientationProtocol(const Address address, const Speed speed, const Orientation orientation, const Protocol protocol)
-			{
-				Z21LocoCacheEntry entry(speed, orientation, protocol);
-				cache[address] = entry;
+				entry->speed = speed;
+				entry->orientation = orientation;
+				entry->functions = 0;
+				entry->protocol = protocol;
 			}
 
-			void SetFunction(const Address address,
+			inline void SetFunction(const Address address,
 				const DataModel::LocoFunctionNr function,
 				const bool on)
 			{
-				Z21LocoCacheEntry entry = GetData(address);
+				Z21LocoCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
+				{
+					return;
+				}
 				uint32_t mask = ~(1 << function);
-				entry.functions &= mask;
-				entry.functions |= on << function;
-				cache[address] = entry;
+				entry->functions &= mask;
+				entry->functions |= on << function;
+			}
+
+			inline uint32_t GetFunctions(const Address address) const
+			{
+				return cache.Get(address).functions;
 			}
 
-			uint32_t GetFunctions(const Address address)
+			inline void SetProtocol(const Address address, const Protocol protocol)
 			{
-				if (cache.count(address) == 0)
+				Z21LocoCacheEntry* entry = cache.Modify(address);
+				if (entry == nullptr)
 				{
-					return 0;
+					return;
 				}
-				return cache[address].functions;
+				entry->protocol = protocol;
 			}
 
-			void SetProtocol(const Address address, const Protocol protocol)
+			inline Protocol GetProtocol(const Address address) const
 			{
-				Z21LocoCacheEntry entry = GetData(address);
-				entry.protocol = protocol;
-				cache[address] = entry;
+				return cache.Get(address).protocol;
 			}
 
-			Protocol GetProtocol(const Address address)
+			// the Z21 has reported the state of the loco, so it knows all our changes
+			inline void Synchronized(const Address address)
 			{
-				if (cache.count(address) == 0)
-				{
-					return ProtocolNone;
-				}
-				return cache[address].protocol;
+				cache.ClearDirty(address);
+			}
+
+			// returns the locos changed by us and not yet reported back by the Z21
+			inline void GetUnsynchronized(std::vector<Address>& addresses) const
+			{
+				cache.GetDirty(addresses);
 			}
 
 		private:
-			std::map<Address, Z21LocoCacheEntry> cache;
+			LocoAddressTable<Z21LocoCacheEntry> cache;
 	};
 } // namespace
-
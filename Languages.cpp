@@ -34,6 +34,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* Text180Deg */ { "180 degrees", "180 Grad", "180 grados" },
 /* Text90DegAntiClockwise */ { "90 degrees anti-clockwise", "90 Grad gegen den Uhrzeigersinn", "90 grados en el sentido contrario de las agujas del reloj" },
 /* Text90DegClockwise */ { "90 degrees clockwise", "90 Grad im Uhrzeigersinn", "90 grados en el sentido de las agujas del reloj" },
+/* TextAccelerationTime */ { "Acceleration time (ms)", "Beschleunigungszeit (ms)", "Tiempo de aceleración (ms)" },
 /* TextAccessories */ { "Accessories", "Zubehörartikel", "Accesorios" },
 /* TextAccessory*/ { "accessory", "Zubehörartikel", "accesorio" },
 /* TextAccessoryAddressDccTooHigh */ { "Addresses higher then 2044 are not supported by DCC", "Adressen grösser als 2044 werden nicht unterstützt von DCC", "Direcciones más grandes que 2044 no están compatibles con DCC" },
@@ -43,7 +44,6 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextAccessoryIsLocked */ { "Accessory {0} is locked", "Zubehörartikel {0} ist gesperrt", "Accesorio {0} está bloqueado" },
 /* TextAccessoryIsUsedByRoute */ { "Accessory {0} is used route {1}", "Zubehörartikel {0} wird von Fahrstrasse {1} benutzt", "Acesorio {0} está utilizado por itinerario {1}" },
 /* TextAccessorySaved */ { "Accessory {0} saved", "Zubehörartikel {0} gespeichert", "Accesorio {0} guardado" },
-/* TextAccessorySenderThreadStarted */ { "Accessory sender thread started", "Zubehörartikel Sender Thread gestartet", "Thread enviador accesorio creado" },
 /* TextAccessoryStateIsGreen */ { "Accessory state of {0} is now green", "Der Status des Zubehörartikels ist nun grün", "El estado del accessorio está verde" },
 /* TextAccessoryStateIsRed */ { "Accessory state of {0} is now red", "Der Status des Zubehörartikels ist nun rot", "El estado del accessorio está rojo" },
 /* TextAccessoryUpdated */ { "Accessory {0} updated", "Zubehörartikel {0} aktualisiert", "Accessorio {0} actualizado" },
@@ -65,12 +65,32 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextAtUnlock */ { "At unlock", "Beim Freigeben", "Durante liberar" },
 /* TextAutomaticallyAddUnknownFeedbacks */ { "Automatically add unknown feedbacks", "Füge unbekannte Rückmelder automatisch hinzu", "Añadir retroseñales desconosidos automaticamente" },
 /* TextAutomode */ { "Automode", "Automode", "Autómodo" },
+/* TextAutoModeDecisionTimes */ { "{0}: {1} automode decisions, average {2}us, maximum {3}us", "{0}: {1} Automodus Entscheidungen, Durchschnitt {2}us, Maximum {3}us", "{0}: {1} decisiones en modo automático, promedio {2}us, máximo {3}us" },
+/* TextAutoModeWorkers */ { "Automode runs on {0} to {1} worker threads", "Automodus läuft auf {0} bis {1} Arbeitsthreads", "Modo automático se ejecuta en {0} a {1} hilos de trabajo" },
+/* TextAutoModeWorkerStarted */ { "Started automode worker thread {0}", "Automodus-Arbeitsthread {0} gestartet", "Iniciado el hilo de trabajo {0} del modo automático" },
 /* TextBasic */ { "Basic data", "Basisdaten", "Datos basicos" },
+/* TextBlockStatistics */ { "{0} drove {1} blocks in automode ({2} per hour), stopped {3} times, {4} stops avoided by reserving in advance ({5} additional blocks per hour)", "{0} ist im Automodus {1} Blöcke gefahren ({2} pro Stunde), hat {3} mal angehalten, {4} Halte durch vorzeitige Reservierung vermieden ({5} zusätzliche Blöcke pro Stunde)", "{0} recorrió {1} bloques en modo automático ({2} por hora), se detuvo {3} veces, {4} paradas evitadas reservando por adelantado ({5} bloques adicionales por hora)" },
 /* TextBlockTrack */ { "Block track", "Blockiere Gleis", "Bloquear vía" },
 /* TextBoosterIsTurnedOff */ { "Booster is turned off", "Booster ist ausgeschaltet", "Booster está apagado" },
 /* TextBoosterIsTurnedOn */ { "Booster is turned on", "Booster ist eingeschaltet", "Booster está encendido" },
+/* TextBrakingIn */ { "{0} starts braking in {1}ms", "{0} beginnt in {1}ms zu bremsen", "{0} empieza a frenar en {1}ms" },
 /* TextBridge */ { "Bridge", "Brücke", "Puente" },
 /* TextBufferStop */ { "End / Buffer Stop", "Ende / Prellbock", "Final / Tope" },
+/* TextCalibratedSpeedStep */ { "{0}: speed step {1} drives {2}mm/s", "{0}: Fahrstufe {1} fährt {2}mm/s", "{0}: el paso de velocidad {1} circula a {2}mm/s" },
+/* TextCalibration */ { "Calibration", "Kalibrierung", "Calibración" },
+/* TextCalibrationAlreadyRunning */ { "Another loco is calibrated right now", "Es wird bereits eine andere Lok kalibriert", "Ya se está calibrando otra locomotora" },
+/* TextCalibrationDistance */ { "Length of measured section (mm)", "Länge der Messstrecke (mm)", "Longitud del tramo de medición (mm)" },
+/* TextCalibrationEnd */ { "End of measured section", "Ende der Messstrecke", "Fin del tramo de medición" },
+/* TextCalibrationLocoInAutoMode */ { "{0} is in automode, no loco may be in automode during a calibration", "{0} ist im Auto-Modus, während einer Kalibrierung darf keine Lok im Auto-Modus sein", "{0} está en modo auto, ninguna locomotora puede estar en modo auto durante una calibración" },
+/* TextCalibrationNeedsReleasedLoco */ { "{0} has to be released to be calibrated", "{0} muss für die Kalibrierung freigegeben sein", "{0} tiene que estar liberado para ser calibrado" },
+/* TextCalibrationNotConfigured */ { "{0} has no measured section configured", "Für {0} ist keine Messstrecke konfiguriert", "{0} no tiene un tramo de medición configurado" },
+/* TextCalibrationRunningNoAutoMode */ { "No loco can be started in automode while a calibration is running", "Während einer Kalibrierung kann keine Lok im Auto-Modus gestartet werden", "Ninguna locomotora puede iniciarse en modo auto durante una calibración" },
+/* TextCalibrationStart */ { "Start of measured section", "Beginn der Messstrecke", "Inicio del tramo de medición" },
+/* TextCalibrationStarted */ { "Calibration of {0} started", "Kalibrierung von {0} gestartet", "Calibración de {0} iniciada" },
+/* TextCalibrationStopped */ { "Calibration of {0} stopped", "Kalibrierung von {0} abgebrochen", "Calibración de {0} detenida" },
+/* TextCalibrationSuspendsFreeTrackStop */ { "An occupied feedback in a free track does not stop the booster until the calibration of {0} ends", "Ein belegter Rückmelder in einem freien Gleis stoppt den Booster nicht bis die Kalibrierung von {0} endet", "Un retroseñal ocupado en una vía libre no detiene el booster hasta que termine la calibración de {0}" },
+/* TextCanFrameQueueFull */ { "CAN frame queue is full, dropping loco frame", "CAN-Frame-Warteschlange ist voll, Lok-Frame wird verworfen", "La cola de tramas CAN está llena, descartando trama de locomotora" },
+/* TextCanFrameStatistics */ { "Sent {0} CAN frames, at most {1} frames were queued", "{0} CAN-Frames gesendet, höchstens {1} Frames waren in der Warteschlange", "Enviadas {0} tramas CAN, como máximo {1} tramas estaban en cola" },
 /* TextCV */ { "CV", "CV", "CV" },
 /* TextCanNotOpenLibrary */ { "Can not open library {0}: {1}", "Kann Bibliothek {0} nicht öffenen: {1}", "Imposible abrir biblioteca {0}: {1}" },
 /* TextCanNotStartAlreadyRunning */ { "Can not start {0} because it is already running", "Unmöglich {0} zu starten weil schon gestartet", "Imposible poner {0} en marcha porque ya está en marcha" },
@@ -117,10 +137,15 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextCs2MasterLocoRemove */ { "CS2 Master has removed locomotive with name {0}", "CS2 Master hat eine Lokomotive mit dem Namen {0} gelöscht", "CS2 master ha eliminado la locomotora con el nombre {0}" },
 /* TextCs2MinorVersionIsNot4 */ { "Minor version of received file is not 4", "Minor Version des erhaltenen files ist nicht 4", "La versión menor no es 4" },
 /* TextDcc */ { "DCC", "DCC", "DCC" },
+/* TextDeadlockAvoided */ { "{0} does not enter {1} because it could not leave it again", "{0} fährt nicht in {1} ein, da sie nicht wieder herausfahren könnte", "{0} no entra en {1} porque no podría salir de nuevo" },
+/* TextDeadlockDetected */ { "Deadlock detected: {0}", "Verklemmung erkannt: {0}", "Bloqueo mutuo detectado: {0}" },
+/* TextDeadlockStatistics */ { "Deadlocks: {0} detected, {1} avoided", "Verklemmungen: {0} erkannt, {1} vermieden", "Bloqueos mutuos: {0} detectados, {1} evitados" },
+/* TextDebounceStatistics */ { "Debouncer released {0} feedbacks, average release latency {1}us, maximum release latency {2}us", "Entpreller hat {0} Rückmelder freigegeben, durchschnittliche Freigabeverzögerung {1}us, maximale Freigabeverzögerung {2}us", "Antirebote ha liberado {0} retroalimentaciones, latencia media de liberación {1}us, latencia máxima de liberación {2}us" },
 /* TextDebounceThreadStarted */ { "Debounce thread started", "Entprellthread gestartet", "Antirebote thread encendido" },
 /* TextDebounceThreadTerminated */ { "Debounce thread terminated", "Entprellthread beedet", "Antirebote thread apagado" },
 /* TextDebouncer */ { "Debouncer", "Entpreller", "Antirebote" },
 /* TextDebug */ { "debug", "Entkäfern", "depurar" },
+/* TextDecelerationTime */ { "Deceleration time (ms)", "Bremszeit (ms)", "Tiempo de frenado (ms)" },
 /* TextDefaultSwitchingDuration */ { "Default switching duration (ms)", "Standard Schaltzeit (ms)", "Duración de conmutación por defecto (ms)" },
 /* TextDelete */ { "Delete", "Löschen", "Eliminar" },
 /* TextDeleteAccessory */ { "Delete accessory", "Zubehörartikel löschen", "Eliminar accesorio" },
@@ -138,9 +163,12 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextDifferentOrientations */ { "Locomotive and route {0} have different running directions", "Lokomotive und Fahrstrasse {0} haben verschiedene Fahrtrichtungen", "Tren e itinerario tienen sentidos de la marcha differentes" },
 /* TextDifferentPushpullTypes */ { "Locomotive and route {0} have different push-pull types", "Lokomotive und Fahrstrasse {0} haben verschiedene Wendezugeinstellungen", "Tren e itinerario tienen ajustes de push-pull differentes" },
 /* TextDirect */ { "Direct", "Direkt", "Directo" },
+/* TextDispatcherQueueFull */ { "Queue holds {0} commands, the control is too slow", "Warteschlange enthält {0} Befehle, die Steuerung ist zu langsam", "La cola contiene {0} comandos, el control es demasiado lento" },
+/* TextDispatcherStatistics */ { "{0} commands dispatched, max queue depth {1}, {2} coalesced, average latency {3} us, max latency {4} us", "{0} Befehle verteilt, maximale Warteschlangenlänge {1}, {2} zusammengefasst, durchschnittliche Latenz {3} us, maximale Latenz {4} us", "{0} comandos distribuidos, longitud máxima de la cola {1}, {2} combinados, latencia media {3} us, latencia máxima {4} us" },
 /* TextDoNotCare */ { "Do not care", "Egal", "No importa" },
 /* TextDroppingTable */ { "Dropping table {0}", "Lösche Tabelle {0}", "Eliminando tabla {0}" },
 /* TextDuration */ { "Switching duration (ms)", "Schaltzeit (ms)", "Duración de conmutación (ms)" },
+/* TextEcosReceiveStatistics */ { "Received {0} lines with {1} reads", "{0} Zeilen mit {1} Lesevorgängen empfangen", "Recibidas {0} líneas con {1} lecturas" },
 /* TextEdit */ { "Edit", "Bearbeiten", "Editar" },
 /* TextEditAccessories */ { "Edit accessories", "Zubehörartikel bearbeiten", "Editar accesorios" },
 /* TextEditAccessory */ { "Edit accessory", "Zubehörartikel bearbeiten", "Editar accesorio" },
@@ -161,13 +189,16 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextEditTracks */ { "Edit tracks", "Gleise bearbeiten", "Editar vías" },
 /* TextEnglish */ { "English", "Englisch", "Ingles" },
 /* TextError */ { "error", "Fehler", "errores" },
+/* TextExecuteRoutesInBatches */ { "Execute routes in batches (route delays are ignored)", "Fahrstrassen gebündelt ausführen (Fahrstrassenverzögerungen werden ignoriert)", "Ejecutar itinerarios en lotes (se ignoran los retardos de itinerarios)" },
 /* TextExecutingRoute */ { "Executing route {0}", "Führe Fahrstrasse {0} aus", "Ejecutando itinerario {0}" },
 /* TextExitRailControl */ { "Exit RailControl", "RailControl beenden", "Apagar RailControl" },
 /* TextFeedback */ { "feedback", "Rückmelder", "retroseñal" },
 /* TextFeedbackChange */ { "State of pin {0} on S88 module {1} is {2}", "Status von Pin {0} an S88 Modul {1} ist {2}", "Estado de contacto {0} del S88 módulo {1} está {2}" },
 /* TextFeedbackDeleted */ { "Feedback {0} deleted", "Rückmelder {0} gelöscht", "Retroseñal {0} eliminado" },
 /* TextFeedbackDoesNotExist */ { "Feedback does not exist", "Rückmelder existiert nicht", "Retroseñal no existe" },
+/* TextFeedbackHandledAfter */ { "Feedback {0} handled after {1}us", "Rückmelder {0} nach {1}us verarbeitet", "Retroalimentación {0} procesada después de {1}us" },
 /* TextFeedbackIsUsedByTrack */ { "Feedback {0} is used by track {1}", "Rückmelder {0} wird gebraucht von Gleis {1}", "Retroseñal {0} está usado por vía {1}" },
+/* TextFeedbackReleaseLatency */ { "Feedback {0} released {1}us after debounce time", "Rückmelder {0} {1}us nach Entprellzeit freigegeben", "Retroalimentación {0} liberada {1}us después del tiempo de antirebote" },
 /* TextFeedbackSaved */ { "Feedback {0} saved", "Rückmelder {0} gespeichert", "Retroseñal {0} guardado" },
 /* TextFeedbackStateIsOff */ { "Feedback state of {0} is now off", "Der Status des Rückmelders {0} ist nun aus", "El estado de la retroseñal {0} está apagada" },
 /* TextFeedbackStateIsOn */ { "Feedback state of {0} is now on", "Der Status des Rückmelders {0} ist nun ein", "El estado de la retroseñal {0} está encendida" },
@@ -213,8 +244,6 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextIsInAutomodeWithoutRouteTrack */ { "{0} is in automode without a route or track set. Setting error state.", "{0} ist im Automodus ohne Fahrstrasse oder Gleis. Setze Fehlerstatus.", "{0} está en modo auto sin itinerario o vía. Poniando estado error." },
 /* TextIsInErrorState */ { "{0} is in error state", "{0} ist im Fehlerstatus", "{0} está en estado error" },
 /* TextIsInInvalidAutomodeState */ { "{0} is running in invalid automode state {1} while {2} is reached. Setting error state.", "{0} ist in unerlaubten Automode Status {1} während {2} erreicht wurde. Setze Fehlerstatus.", "{0} está en estado ilegal {1} mientras llegando {2}. Poniando estado error." },
-/* TextIsInManualState */ { "{0} is in manual state while automode is running. Setting error state.", "{0} ist im Status manuell während der Auto-Modus eingeschaltet ist. Setze Fehlerstatus.", "{0} está en estado manual durante modo auto. Poniando estado error." },
-/* TextIsInTerminatedState */ { "{0} is in terminated state while automode is running. Setting error state.", "{0} ist im Status beendet während der Auto-Modus eingeschaltet ist. Setze Fehlerstatus.", "{0} está en estado terminado durante modo auto. Poniando estado error." },
 /* TextIsLocked */ { "{0} is locked", "{0} ist gesperrt", "{0} está bloqueado" },
 /* TextIsNotFree */ { "{0} is not free", "{0} ist nicht frei", "{0} no está libre" },
 /* TextIsNotOnTrack */ { "{0} is not on a track. Switching to manual mode.", "{0} ist nicht auf einem Gleis. Wechsle in den Modus manuell.", "{0} no está sobre una vía. Poniando en modo manual." },
@@ -255,6 +284,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextLoco */ { "Locomotive", "Lokomotive", "Locomotora" },
 /* TextLocoAddressDccTooHigh */ { "Addresses higher then 10239 are not supported by DCC", "Adressen grösser als 10239 werden nicht unterstützt von DCC", "Direcciones más grandes que 10239 no están compatibles con DCC" },
 /* TextLocoAddressMmTooHigh */ { "Addresses higher then 80 are not supported by MM1/MM2", "Adressen grösser als 80 werden nicht unterstützt von MM1/MM2", "Direcciones más grandes que 80 no están compatibles con MM1/MM2" },
+/* TextLocoCalibrated */ { "{0} is calibrated", "{0} ist kalibriert", "{0} está calibrado" },
 /* TextLocoDeleted */ { "Locomotive {0} deleted", "Lokomotive {0} gelöscht", "Locomotora {0} eliminado" },
 /* TextLocoDirectionOfTravelIsLeft */ { "Direction of travel of {0} is now left", "Die Fahrtrichtung von {0} ist links", "La dirección de viaje  de {0} está izquierda" },
 /* TextLocoDirectionOfTravelIsRight */ { "Direction of travel  of {0} is now right", "Die Fahrtrichtung von {0} ist rechts", "La dirección de viaje de {0} está derecha" },
@@ -416,6 +446,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextPosZ */ { "Layer", "Schicht", "Capa" },
 /* TextPosition */ { "Position", "Position", "Posición" },
 /* TextPositionAlreadyInUse */ { "Position {0}/{1}/{2} is already used by {3} \"{4}\".", "Position {0}/{1}/{2} wird bereits verwendet von {3} \"{4}\".", "Positión {0}/{1}/{2} está usado de {3} \"{4}\"." },
+/* TextPreReservedRoute */ { "Route {0} reserved in advance", "Fahrstrasse {0} vorzeitig reserviert", "Itinerario {0} reservado por adelantado" },
 /* TextProgramDccPomAccessoryRead */ { "Reading DCC CV {1} of accessory with address {0} on main", "Lese DCC CV {1} des Zubehörartikels mit Adresse {0} auf dem Hauptgleis", "Leyendo DCC CV {1} del acessorio con dirección {0} en vía principal" },
 /* TextProgramDccPomAccessoryWrite */ { "Programming DCC CV {1} of accessory with address {0} on main to value {2}", "Programmiere DCC CV {1} auf Wert {2} des Zubehörartikels mit Adresse {0} auf dem Hauptgleis", "Escribiendo DCC CV {1} al valor {2} del acessorio con dirección {0} en vía principal" },
 /* TextProgramDccPomLocoRead */ { "Reading DCC CV {1} of locomotive with address {0} on main", "Lese DCC CV {1} der Lokomotive mit Adresse {0} auf dem Hauptgleis", "Leyendo DCC CV {1} de la locomotora con dirección {0} en vía principal" },
@@ -441,6 +472,8 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextPushPullOnly */ { "push-pull trains only", "nur Wendezüge", "solamente push-pull trenes" },
 /* TextPushPullTrain */ { "Push-Pull train", "Wendezug", "Tren push-pull" },
 /* TextQuery */ { "Query: {0} Rows affected {1}", "Abfrage: {0} Geänderte Datensätze: {1}", "Consulta: {0} Líneas afectados: {1}" },
+/* TextReservationStatistics */ { "Route reservations: {0} committed, {1} rejected without changes, {2} rolled back, {3} waited for another reservation", "Fahrstrassenreservationen: {0} ausgeführt, {1} ohne Änderungen abgelehnt, {2} rückgängig gemacht, {3} auf andere Reservation gewartet", "Reservas de itinerarios: {0} confirmadas, {1} rechazadas sin cambios, {2} revertidas, {3} esperaron otra reserva" },
+/* TextResynchronizingLocos */ { "Resynchronizing {0} locos with command station", "Synchronisiere {0} Lokomotiven erneut mit der Zentrale", "Resincronizando {0} locomotoras con la central" },
 /* TextRM485ModuleFound */ { "RM485 module {0} found", "RM485 Modul {0} gefunden", "Modulo RM485 {0} encontrado" },
 /* TextRailControlStarted */ { "RailControl started", "RailControl wurde gestartet", "RailControl encendido" },
 /* TextRandom */ { "Random", "Zufall", "Aleatorio" },
@@ -479,7 +512,13 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextRouteIsLocked */ { "Route {0} is locked", "Fahrstrasse {0} ist gesperrt", "Itinerario {0} está bloqueado" },
 /* TextRouteIsReleased */ { "Route {0} is released", "Fahrstrasse {0} ist freigegeben", "Itinerario {0} está desbloqueado" },
 /* TextRouteIsUsedByRoute */ { "Route {0} is used route {1}", "Fahrstrasse {0} wird von Fahrstrasse {1} benutzt", "Itinerario {0} está utilizado por itinerario {1}" },
+/* TextRoutePlan */ { "{0} reaches {1} via {2}", "{0} erreicht {1} über {2}", "{0} llega a {1} por {2}" },
+/* TextRoutePlanNotFound */ { "{0} can not reach {1}", "{0} kann {1} nicht erreichen", "{0} no puede llegar a {1}" },
+/* TextRoutePlanNotOnTrack */ { "{0} is not on a track, no route can be planned", "{0} ist nicht auf einem Gleis, es kann keine Fahrstrasse geplant werden", "{0} no está sobre una vía, no se puede planificar ningún itinerario" },
+/* TextRoutePlanSlow */ { "Planning the routes of {0} took {1}µs, more than {2}µs", "Planen der Fahrstrassen von {0} dauerte {1}µs, länger als {2}µs", "Planificar los itinerarios de {0} tardó {1}µs, más de {2}µs" },
+/* TextRoutePlanTime */ { "Planned the routes of {0} in {1}µs", "Fahrstrassen von {0} in {1}µs geplant", "Itinerarios de {0} planificados en {1}µs" },
 /* TextRouteSaved */ { "Route {0} saved", "Fahrstrasse {0} gespeichert", "Itinerario {0} guardado" },
+/* TextRouteSetUpTime */ { "Route {0} set up in {1}ms", "Fahrstrasse {0} in {1}ms gestellt", "Itinerario {0} establecido en {1}ms" },
 /* TextRouteUpdated */ { "Route {0} updated", "Fahrstrasse {0} aktualisiert", "Itinerario {0} actualizado" },
 /* TextRoutes */ { "Routes", "Fahrstrassen", "Itinerarios" },
 /* TextSQLiteErrorQuery */ { "SQLite error: {0} Query: {1}", "SQLite Fehler: {0} Query: {1}", "Error de SQLite: {0} Query: {1}" },
@@ -548,7 +587,6 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextSwitchUpdated */ { "Switch {0} updated", "Weiche {0} aktualisiert", "Desvío {0} actualizado" },
 /* TextSwitches */ { "Switches", "Weichen", "Desvíos" },
 /* TextSystemDefault */ { "System setting", "Systemeinstellung", "Configuración del sistema" },
-/* TextTerminatingAccessorySenderThread */ { "Terminating accessory sender thread", "Beende Zubehörartikel Sender Thread", "Apagando thread enviador accesorio" },
 /* TextTerminatingHeartBeatThread */ { "Terminating heartbeat thread", "Beende Heartbeat-Thread", "Apagando thread heartbeat" },
 /* TextTerminatingReceiverThread */ { "Terminating receiver thread", "Beende Empfangs-Thread", "Apagando thread recibiendo" },
 /* TextTerminatingSenderSocket */ { "Terminating sender socket", "Beende Sende Socket", "Apagando socket enviando" },
@@ -630,6 +668,7 @@ const char* Languages::languages[MaxTexts][MaxLanguages] =
 /* TextWebServerStopped */ { "Webserver stopped", "Webserver wurde beendet", "Servidor web apagado" },
 /* TextWidthIs0 */ { "Width is zero", "Breite ist null", "Anchura está zero" },
 /* TextWrite */ { "write", "schreiben", "escribir" },
+/* TextZ21BatchStatistics */ { "Sent {0} commands in {1} datagrams, batching saved {2} datagrams", "{0} Befehle in {1} Datagrammen gesendet, Zusammenfassen sparte {2} Datagramme", "Enviados {0} comandos en {1} datagramas, la agrupación ahorró {2} datagramas" },
 /* TextZ21Black2012 */ { "black Z21, hardware 2012", "schwarzen Z21, Hardware 2012", "Z21 negro, hardware 2012" },
 /* TextZ21Black2013 */ { "black Z21, hardware 2013", "schwarzen Z21, Hardware 2013", "Z21 negro, hardware 2013" },
 /* TextZ21DoesNotUnderstand */ { "Z21 does not understand our command", "Z21 versteht unser Kommando nicht", "Z21 no ha endendido nuestro comando" },
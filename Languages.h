@@ -34,6 +34,7 @@ class Languages
 			Text180Deg,
 			Text90DegAntiClockwise,
 			Text90DegClockwise,
+			TextAccelerationTime,
 			TextAccessories,
 			TextAccessory,
 			TextAccessoryAddressDccTooHigh,
@@ -43,7 +44,6 @@ class Languages
 			TextAccessoryIsLocked,
 			TextAccessoryIsUsedByRoute,
 			TextAccessorySaved,
-			TextAccessorySenderThreadStarted,
 			TextAccessoryStateIsGreen,
 			TextAccessoryStateIsRed,
 			TextAccessoryUpdated,
@@ -65,12 +65,32 @@ class Languages
 			TextAtUnlock,
 			TextAutomaticallyAddUnknownFeedbacks,
 			TextAutomode,
+			TextAutoModeDecisionTimes,
+			TextAutoModeWorkers,
+			TextAutoModeWorkerStarted,
 			TextBasic,
+			TextBlockStatistics,
 			TextBlockTrack,
 			TextBoosterIsTurnedOff,
 			TextBoosterIsTurnedOn,
+			TextBrakingIn,
 			TextBridge,
 			TextBufferStop,
+			TextCalibratedSpeedStep,
+			TextCalibration,
+			TextCalibrationAlreadyRunning,
+			TextCalibrationDistance,
+			TextCalibrationEnd,
+			TextCalibrationLocoInAutoMode,
+			TextCalibrationNeedsReleasedLoco,
+			TextCalibrationNotConfigured,
+			TextCalibrationRunningNoAutoMode,
+			TextCalibrationStart,
+			TextCalibrationStarted,
+			TextCalibrationStopped,
+			TextCalibrationSuspendsFreeTrackStop,
+			TextCanFrameQueueFull,
+			TextCanFrameStatistics,
 			TextCV,
 			TextCanNotOpenLibrary,
 			TextCanNotStartAlreadyRunning,
@@ -117,10 +137,15 @@ class Languages
 			TextCs2MasterLocoRemove,
 			TextCs2MinorVersionIsNot4,
 			TextDcc,
+			TextDeadlockAvoided,
+			TextDeadlockDetected,
+			TextDeadlockStatistics,
+			TextDebounceStatistics,
 			TextDebounceThreadStarted,
 			TextDebounceThreadTerminated,
 			TextDebouncer,
 			TextDebug,
+			TextDecelerationTime,
 			TextDefaultSwitchingDuration,
 			TextDelete,
 			TextDeleteAccessory,
@@ -138,9 +163,12 @@ class Languages
 			TextDifferentOrientations,
 			TextDifferentPushpullTypes,
 			TextDirect,
+			TextDispatcherQueueFull,
+			TextDispatcherStatistics,
 			TextDoNotCare,
 			TextDroppingTable,
 			TextDuration,
+			TextEcosReceiveStatistics,
 			TextEdit,
 			TextEditAccessories,
 			TextEditAccessory,
@@ -161,13 +189,16 @@ class Languages
 			TextEditTracks,
 			TextEnglish,
 			TextError,
+			TextExecuteRoutesInBatches,
 			TextExecutingRoute,
 			TextExitRailControl,
 			TextFeedback,
 			TextFeedbackChange,
 			TextFeedbackDeleted,
 			TextFeedbackDoesNotExist,
+			TextFeedbackHandledAfter,
 			TextFeedbackIsUsedByTrack,
+			TextFeedbackReleaseLatency,
 			TextFeedbackSaved,
 			TextFeedbackStateIsOff,
 			TextFeedbackStateIsOn,
@@ -213,8 +244,6 @@ class Languages
 			TextIsInAutomodeWithoutRouteTrack,
 			TextIsInErrorState,
 			TextIsInInvalidAutomodeState,
-			TextIsInManualState,
-			TextIsInTerminatedState,
 			TextIsLockedBy,
 			TextIsNotFree,
 			TextIsNotOnTrack,
@@ -255,6 +284,7 @@ class Languages
 			TextLoco,
 			TextLocoAddressDccTooHigh,
 			TextLocoAddressMmTooHigh,
+			TextLocoCalibrated,
 			TextLocoDeleted,
 			TextLocoDirectionOfTravelIsLeft,
 			TextLocoDirectionOfTravelIsRight,
@@ -416,6 +446,7 @@ class Languages
 			TextPosZ,
 			TextPosition,
 			TextPositionAlreadyInUse,
+			TextPreReservedRoute,
 			TextProgramDccPomAccessoryRead,
 			TextProgramDccPomAccessoryWrite,
 			TextProgramDccPomLocoRead,
@@ -441,6 +472,8 @@ class Languages
 			TextPushPullOnly,
 			TextPushPullTrain,
 			TextQuery,
+			TextReservationStatistics,
+			TextResynchronizingLocos,
 			TextRM485ModuleFound,
 			TextRailControlStarted,
 			TextRandom,
@@ -479,7 +512,13 @@ class Languages
 			TextRouteIsLocked,
 			TextRouteIsReleased,
 			TextRouteIsUsedByRoute,
+			TextRoutePlan,
+			TextRoutePlanNotFound,
+			TextRoutePlanNotOnTrack,
+			TextRoutePlanSlow,
+			TextRoutePlanTime,
 			TextRouteSaved,
+			TextRouteSetUpTime,
 			TextRouteUpdated,
 			TextRoutes,
 			TextSQLiteErrorQuery,
@@ -548,7 +587,6 @@ class Languages
 			TextSwitchUpdated,
 			TextSwitches,
 			TextSystemDefault,
-			TextTerminatingAccessorySenderThread,
 			TextTerminatingHeartBeatThread,
 			TextTerminatingReceiverThread,
 			TextTerminatingSenderSocket,
@@ -630,6 +668,7 @@ class Languages
 			TextWebServerStopped,
 			TextWidthIs0,
 			TextWrite,
+			TextZ21BatchStatistics,
 			TextZ21Black2012,
 			TextZ21Black2013,
 			TextZ21DoesNotUnderstand,
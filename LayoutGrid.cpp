@@ -0,0 +1,144 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <climits>
+
+#include "Languages.h"
+#include "LayoutGrid.h"
+#include "Logger/Logger.h"
+
+using DataModel::LayoutItem;
+using std::string;
+using std::vector;
+
+LayoutGrid::LayoutGrid()
+{
+}
+
+void LayoutGrid::Update(const ObjectType type, LayoutItem* item)
+{
+	const ItemKey itemKey = GetItemKey(type, item);
+	std::lock_guard<std::mutex> guard(gridMutex);
+	RemoveUnlocked(itemKey, item);
+
+	// invisible items do not use any position
+	if (item->GetVisible() == LayoutItem::VisibleNo)
+	{
+		return;
+	}
+
+	LayoutItem::LayoutPosition x;
+	LayoutItem::LayoutPosition y;
+	LayoutItem::LayoutPosition z;
+	LayoutItem::LayoutItemSize w;
+	LayoutItem::LayoutItemSize h;
+	LayoutItem::LayoutRotation r;
+	if (item->Position(x, y, z, w, h, r) == false)
+	{
+		return;
+	}
+
+	Placement& placement = placements[itemKey];
+	placement.posZ = z;
+	for (int ix = x; ix < x + w && ix <= CHAR_MAX; ++ix)
+	{
+		for (int iy = y; iy < y + h && iy <= CHAR_MAX; ++iy)
+		{
+			const CellKey cellKey = GetCellKey(static_cast<LayoutItem::LayoutPosition>(ix), static_cast<LayoutItem::LayoutPosition>(iy), z);
+			cells[cellKey].push_back(item);
+			placement.cells.push_back(cellKey);
+		}
+	}
+	layers[z][itemKey] = item;
+}
+
+void LayoutGrid::Remove(const ObjectType type, const LayoutItem* item)
+{
+	std::lock_guard<std::mutex> guard(gridMutex);
+	RemoveUnlocked(GetItemKey(type, item), item);
+}
+
+bool LayoutGrid::CheckPositionFree(const LayoutItem::LayoutPosition posX,
+	const LayoutItem::LayoutPosition posY,
+	const LayoutItem::LayoutPosition posZ,
+	string& result) const
+{
+	std::lock_guard<std::mutex> guard(gridMutex);
+	auto cell = cells.find(GetCellKey(posX, posY, posZ));
+	if (cell == cells.end() || cell->second.empty())
+	{
+		return true;
+	}
+	const LayoutItem* item = cell->second.front();
+	result.assign(Logger::Logger::Format(Languages::GetText(Languages::TextPositionAlreadyInUse), static_cast<int>(posX), static_cast<int>(posY), static_cast<int>(posZ), item->GetLayoutType(), item->GetName()));
+	return false;
+}
+
+void LayoutGrid::GetItemsOnLayer(const LayoutItem::LayoutPosition posZ, vector<Item>& items) const
+{
+	std::lock_guard<std::mutex> guard(gridMutex);
+	auto layer = layers.find(posZ);
+	if (layer == layers.end())
+	{
+		return;
+	}
+	for (auto entry : layer->second)
+	{
+		if (entry.second->GetVisible() != LayoutItem::VisibleYes)
+		{
+			continue;
+		}
+		items.push_back(Item(static_cast<ObjectType>(entry.first >> 16), entry.second));
+	}
+}
+
+void LayoutGrid::RemoveUnlocked(const ItemKey itemKey, const LayoutItem* item)
+{
+	auto placement = placements.find(itemKey);
+	if (placement == placements.end())
+	{
+		return;
+	}
+	for (auto cellKey : placement->second.cells)
+	{
+		auto cell = cells.find(cellKey);
+		if (cell == cells.end())
+		{
+			continue;
+		}
+		vector<LayoutItem*>& items = cell->second;
+		items.erase(std::remove(items.begin(), items.end(), item), items.end());
+		if (items.empty())
+		{
+			cells.erase(cell);
+		}
+	}
+	auto layer = layers.find(placement->second.posZ);
+	if (layer != layers.end())
+	{
+		layer->second.erase(itemKey);
+		if (layer->second.empty())
+		{
+			layers.erase(layer);
+		}
+	}
+	placements.erase(placement);
+}
@@ -0,0 +1,89 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DataTypes.h"
+#include "DataModel/LayoutItem.h"
+
+// Knows for every cell of every layer which layout items are covering it and which items are
+// placed on a layer. Checking if a position is free and collecting the items to draw on a
+// layer only touch the items of that cell or layer instead of all objects.
+// The manager has to update the grid whenever an item is saved and remove the item before it
+// gets deleted.
+class LayoutGrid
+{
+	public:
+		typedef std::pair<ObjectType,DataModel::LayoutItem*> Item;
+
+		LayoutGrid();
+
+		// places the item at its current position, size, rotation and visibility
+		void Update(const ObjectType type, DataModel::LayoutItem* item);
+		void Remove(const ObjectType type, const DataModel::LayoutItem* item);
+
+		// returns false and the item using the position in result if the position is not free
+		bool CheckPositionFree(const DataModel::LayoutItem::LayoutPosition posX,
+			const DataModel::LayoutItem::LayoutPosition posY,
+			const DataModel::LayoutItem::LayoutPosition posZ,
+			std::string& result) const;
+
+		// returns the visible items of a layer ordered by type and ID
+		void GetItemsOnLayer(const DataModel::LayoutItem::LayoutPosition posZ, std::vector<Item>& items) const;
+
+	private:
+		typedef uint32_t ItemKey;
+		typedef uint32_t CellKey;
+
+		struct Placement
+		{
+			DataModel::LayoutItem::LayoutPosition posZ;
+			std::vector<CellKey> cells;
+		};
+
+		static inline ItemKey GetItemKey(const ObjectType type, const DataModel::LayoutItem* item)
+		{
+			return (static_cast<ItemKey>(type) << 16) | item->GetID();
+		}
+
+		static inline CellKey GetCellKey(const DataModel::LayoutItem::LayoutPosition posX,
+			const DataModel::LayoutItem::LayoutPosition posY,
+			const DataModel::LayoutItem::LayoutPosition posZ)
+		{
+			return (static_cast<CellKey>(static_cast<uint8_t>(posZ)) << 16)
+				| (static_cast<CellKey>(static_cast<uint8_t>(posX)) << 8)
+				| static_cast<CellKey>(static_cast<uint8_t>(posY));
+		}
+
+		void RemoveUnlocked(const ItemKey itemKey, const DataModel::LayoutItem* item);
+
+		mutable std::mutex gridMutex;
+		std::unordered_map<CellKey,std::vector<DataModel::LayoutItem*>> cells;
+		std::map<DataModel::LayoutItem::LayoutPosition,std::map<ItemKey,DataModel::LayoutItem*>> layers;
+		std::map<ItemKey,Placement> placements;
+};
@@ -18,6 +18,7 @@ along with RailControl; see the file LICENCE. If not see
 <http://www.gnu.org/licenses/>.
 */
 
+#include <algorithm>
 #include <future>
 #include <iostream>
 #include <sstream>
@@ -49,14 +50,33 @@ using Storage::StorageParams;
 Manager::Manager(Config& config)
 :	logger(Logger::Logger::GetLogger(Languages::GetText(Languages::TextManager))),
  	boosterState(BoosterStateStop),
+	controlWaiters(0),
 	storage(nullptr),
 	defaultAccessoryDuration(DataModel::DefaultAccessoryPulseDuration),
 	autoAddFeedback(false),
 	stopOnFeedbackInFreeTrack(true),
+	executeRoutesInBatches(false),
+	autoModeIdleRecheck(1000),
+	z21BatchWindow(0),
+	m6051CommandGap(0),
 	selectRouteApproach(DataModel::SelectRouteRandom),
 	nrOfTracksToReserve(DataModel::Loco::ReserveOne),
+	autoModeScheduler(nullptr),
+	speedRamp(nullptr),
+	speedCalibration(this),
 	run(false),
 	debounceRun(false),
+	debounceResolution(MinDebounceResolution),
+	debounceEpoch(std::chrono::steady_clock::now()),
+	debounceReleased(0),
+	debounceSumLatency(0),
+	debounceMaxLatency(0),
+	reservationsCommitted(0),
+	reservationsRejected(0),
+	reservationsRolledBack(0),
+	reservationsContended(0),
+	deadlocksDetected(0),
+	deadlocksAvoided(0),
 	initLocosDone(false),
 	unknownControl(Languages::GetText(Languages::TextControlDoesNotExist)),
 	unknownLoco(Languages::GetText(Languages::TextLocoDoesNotExist)),
@@ -83,16 +103,24 @@ Manager::Manager(Config& config)
 	defaultAccessoryDuration = Utils::Utils::StringToInteger(storage->GetSetting("DefaultAccessoryDuration"), 250);
 	autoAddFeedback = Utils::Utils::StringToBool(storage->GetSetting("AutoAddFeedback"));
 	stopOnFeedbackInFreeTrack = Utils::Utils::StringToBool(storage->GetSetting("StopOnFeedbackInFreeTrack"), true);
+	executeRoutesInBatches = Utils::Utils::StringToBool(storage->GetSetting("ExecuteRoutesInBatches"), false);
 	selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::StringToInteger(storage->GetSetting("SelectRouteApproach")));
-	nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(Utils::Utils::StringToInteger(storage->GetSetting("NrOfTracksToReserve"), 2));
+	nrOfTracksToReserve = CheckNrOfTracksToReserve(Utils::Utils::StringToInteger(storage->GetSetting("NrOfTracksToReserve"), 2));
+	autoModeIdleRecheck = std::chrono::milliseconds(std::max(config.getValue("automodeidlerecheck", 1000), static_cast<int>(MinAutoModeIdleRecheck)));
+	debounceResolution = std::chrono::milliseconds(std::max(config.getValue("debounceresolution", 50), static_cast<int>(MinDebounceResolution)));
+	z21BatchWindow = std::chrono::milliseconds(std::min(std::max(config.getValue("z21batchwindow", 5), 0), static_cast<int>(MaxZ21BatchWindow)));
+	m6051CommandGap = std::min(std::max(config.getValue("m6051commandgap", 50), 0), static_cast<int>(MaxM6051CommandGap));
 
 	controls[ControlIdWebserver] = new WebServer::WebServer(*this, config.getValue("webserverport", 8080));
+	dispatchers[ControlIdWebserver] = new ControlDispatcher(controls[ControlIdWebserver]);
 
 	storage->AllHardwareParams(hardwareParams);
 	for (auto hardwareParam : hardwareParams)
 	{
 		hardwareParam.second->SetManager(this);
-		controls[hardwareParam.second->GetControlID()] = new HardwareHandler(*this, hardwareParam.second);
+		ControlInterface* control = new HardwareHandler(*this, hardwareParam.second);
+		controls[hardwareParam.second->GetControlID()] = control;
+		dispatchers[hardwareParam.second->GetControlID()] = new ControlDispatcher(control);
 		logger->Info(Languages::TextLoadedControl, hardwareParam.first, hardwareParam.second->GetName());
 	}
 
@@ -123,18 +151,30 @@ Manager::Manager(Config& config)
 			accessory.second->SetProtocol(ProtocolMM);
 		}
 		logger->Info(Languages::TextLoadedAccessory, accessory.second->GetID(), accessory.second->GetName());
+		layoutGrid.Update(ObjectTypeAccessory, accessory.second);
 	}
+	HardwareAddressIndexBuild(accessoriesByAddress, accessories);
 
 	storage->AllFeedbacks(feedbacks);
 	for (auto feedback : feedbacks)
 	{
 		logger->Info(Languages::TextLoadedFeedback, feedback.second->GetID(), feedback.second->GetName());
+		layoutGrid.Update(ObjectTypeFeedback, feedback.second);
+	}
+	for (auto feedback : feedbacks)
+	{
+		ControlID feedbackControlID = feedback.second->GetControlID();
+		if (feedbacksByPin[feedbackControlID].empty())
+		{
+			FeedbackPinTableBuild(feedbackControlID);
+		}
 	}
 
 	storage->AllTracks(tracks);
 	for (auto track : tracks)
 	{
 		logger->Info(Languages::TextLoadedTrack, track.second->GetID(), track.second->GetName());
+		layoutGrid.Update(ObjectTypeTrack, track.second);
 	}
 
 	storage->AllSwitches(switches);
@@ -149,7 +189,9 @@ Manager::Manager(Config& config)
 			mySwitch.second->SetProtocol(ProtocolMM);
 		}
 		logger->Info(Languages::TextLoadedSwitch, mySwitch.second->GetID(), mySwitch.second->GetName());
+		layoutGrid.Update(ObjectTypeSwitch, mySwitch.second);
 	}
+	HardwareAddressIndexBuild(switchesByAddress, switches);
 
 	storage->AllSignals(signals);
 	for (auto signal : signals)
@@ -163,7 +205,9 @@ Manager::Manager(Config& config)
 			signal.second->SetProtocol(ProtocolMM);
 		}
 		logger->Info(Languages::TextLoadedSignal, signal.second->GetID(), signal.second->GetName());
+		layoutGrid.Update(ObjectTypeSignal, signal.second);
 	}
+	HardwareAddressIndexBuild(signalsByAddress, signals);
 
 	storage->AllClusters(clusters);
 	for (auto cluster : clusters)
@@ -175,6 +219,9 @@ Manager::Manager(Config& config)
 	for (auto route : routes)
 	{
 		logger->Info(Languages::TextLoadedRoute, route.second->GetID(), route.second->GetName());
+		layoutGrid.Update(ObjectTypeRoute, route.second);
+		RouteConflictsUpdate(route.second);
+		routeUsage.Update(route.second);
 	}
 
 	storage->AllLocos(locos);
@@ -190,8 +237,11 @@ Manager::Manager(Config& config)
 		}
 		logger->Info(Languages::TextLoadedLoco, loco.second->GetID(), loco.second->GetName());
 	}
+	HardwareAddressIndexBuild(locosByAddress, locos);
 
 	run = true;
+	autoModeScheduler = new AutoModeScheduler(std::max(config.getValue("automodeworkers", 16), 0));
+	speedRamp = new SpeedRamp(this);
 	debounceRun = true;
 	debounceThread = std::thread(&Manager::DebounceWorker, this);
 	InitLocos();
@@ -204,12 +254,39 @@ Manager::~Manager()
 		Utils::Utils::SleepForSeconds(1);
 	}
 
-	debounceRun = false;
+	{
+		std::lock_guard<std::mutex> guard(debounceMutex);
+		debounceRun = false;
+		debounceCondition.notify_all();
+	}
 	debounceThread.join();
 
+	logger->Info(Languages::TextReservationStatistics,
+		reservationsCommitted,
+		reservationsRejected,
+		reservationsRolledBack,
+		reservationsContended);
+	logger->Info(Languages::TextDeadlockStatistics, deadlocksDetected, deadlocksAvoided);
+
+	// all locos are in manual mode, only stale wake ups can be left in the scheduler
+	delete autoModeScheduler;
+	autoModeScheduler = nullptr;
+	delete speedRamp;
+	speedRamp = nullptr;
+
 	Booster(ControlTypeInternal, BoosterStateStop);
 
 	run = false;
+	std::map<ControlID,ControlDispatcher*> dispatchersToDelete;
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		dispatchersToDelete.swap(dispatchers);
+	}
+	for (auto dispatcher : dispatchersToDelete)
+	{
+		delete dispatcher.second;
+	}
+
 	{
 		std::lock_guard<std::mutex> guard(controlMutex);
 		for (auto control : controls)
@@ -246,6 +323,10 @@ Manager::~Manager()
 		storage->StartTransaction();
 	}
 
+	locosByAddress.clear();
+	accessoriesByAddress.clear();
+	switchesByAddress.clear();
+	signalsByAddress.clear();
 	DeleteAllMapEntries(locos, locoMutex);
 	DeleteAllMapEntries(clusters, clusterMutex);
 	DeleteAllMapEntries(routes, routeMutex);
@@ -277,13 +358,11 @@ void Manager::Booster(const ControlType controlType, const BoosterState state)
 		return;
 	}
 	boosterState = state;
-	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandBooster, controlType),
+		[=] (ControlInterface* control)
 		{
-			control.second->Booster(controlType, state);
-		}
-	}
+			control->Booster(controlType, state);
+		});
 
 	if (boosterState != BoosterStateGo || initLocosDone == true)
 	{
@@ -300,12 +379,16 @@ void Manager::InitLocos()
 	std::lock_guard<std::mutex> guard(locoMutex);
 	for (auto loco : locos)
 	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
-		{
-			std::vector<DataModel::LocoFunctionEntry> functions = loco.second->GetFunctionStates();
-			control.second->LocoSpeedOrientationFunctions(loco.second, loco.second->GetSpeed(), loco.second->GetOrientation(), functions);
-		}
+		Loco* locoInit = loco.second;
+		const Speed speed = locoInit->GetSpeed();
+		const Orientation orientation = locoInit->GetOrientation();
+		std::vector<DataModel::LocoFunctionEntry> functions = locoInit->GetFunctionStates();
+		DispatchToControls(ControlDispatcher::KeyNone,
+			[=] (ControlInterface* control)
+			{
+				std::vector<DataModel::LocoFunctionEntry> functionsCopy = functions;
+				control->LocoSpeedOrientationFunctions(locoInit, speed, orientation, functionsCopy);
+			});
 	}
 }
 
@@ -365,6 +448,7 @@ bool Manager::ControlSave(const ControlID& controlID,
 			return false;
 		}
 		controls[params->GetControlID()] = control;
+		dispatchers[params->GetControlID()] = new ControlDispatcher(control);
 		return true;
 	}
 
@@ -374,12 +458,15 @@ bool Manager::ControlSave(const ControlID& controlID,
 		return false;
 	}
 
+	WaitUntilDispatchedToControls();
 	control->ReInit(params);
 	return true;
 }
 
 bool Manager::ControlDelete(ControlID controlID)
 {
+	ControlInterface* control = nullptr;
+	ControlDispatcher* dispatcher = nullptr;
 	{
 		std::lock_guard<std::mutex> guard(hardwareMutex);
 		if (controlID < ControlIdFirstHardware || hardwareParams.count(controlID) != 1)
@@ -401,14 +488,29 @@ bool Manager::ControlDelete(ControlID controlID)
 		{
 			return false;
 		}
-		ControlInterface* control = controls.at(controlID);
+		control = controls.at(controlID);
 		if (control == nullptr)
 		{
 			return false;
 		}
 		controls.erase(controlID);
-		delete control;
+		if (dispatchers.count(controlID) == 1)
+		{
+			dispatcher = dispatchers.at(controlID);
+			dispatchers.erase(controlID);
+		}
+	}
+	{
+		// a waiting thread may still use the control it has taken before it was erased
+		std::unique_lock<std::mutex> lock(controlMutex);
+		while (controlWaiters > 0)
+		{
+			controlWaitersCondition.wait(lock);
+		}
 	}
+	// deleting the dispatcher executes all queued tasks before the control gets deleted
+	delete dispatcher;
+	delete control;
 
 	if (storage)
 	{
@@ -497,6 +599,52 @@ ControlInterface* Manager::GetControl(const ControlID controlID) const
 	return controls.at(controlID);
 }
 
+void Manager::DispatchToControls(const ControlDispatcher::Key key, const ControlDispatcher::Task& task) const
+{
+	std::lock_guard<std::mutex> guard(controlMutex);
+	for (auto dispatcher : dispatchers)
+	{
+		dispatcher.second->Dispatch(key, task);
+	}
+}
+
+void Manager::WaitUntilDispatchedToControls() const
+{
+	// waiting is done without holding controlMutex, a queued task may call back into the manager
+	std::vector<ControlDispatcher*> dispatchersToWait;
+	{
+		std::lock_guard<std::mutex> guard(controlMutex);
+		for (auto dispatcher : dispatchers)
+		{
+			dispatchersToWait.push_back(dispatcher.second);
+		}
+		++controlWaiters;
+	}
+	for (auto dispatcher : dispatchersToWait)
+	{
+		dispatcher->WaitUntilDispatched();
+	}
+	ControlWaitDone();
+}
+
+void Manager::ControlWaitDone() const
+{
+	std::lock_guard<std::mutex> guard(controlMutex);
+	--controlWaiters;
+	controlWaitersCondition.notify_all();
+}
+
+bool Manager::GetControlDispatcherStatistics(const ControlID controlID, ControlDispatcher::Statistics& statistics) const
+{
+	std::lock_guard<std::mutex> guard(controlMutex);
+	if (dispatchers.count(controlID) != 1)
+	{
+		return false;
+	}
+	statistics = dispatchers.at(controlID)->GetStatistics();
+	return true;
+}
+
 const std::string Manager::GetControlName(const ControlID controlID)
 {
 	std::lock_guard<std::mutex> guard(controlMutex);
@@ -647,16 +795,7 @@ DataModel::Loco* Manager::GetLoco(const LocoID locoID) const
 Loco* Manager::GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(locoMutex);
-	for (auto loco : locos)
-	{
-		if (loco.second->GetControlID() == controlID
-			&& loco.second->GetProtocol() == protocol
-			&& loco.second->GetAddress() == address)
-		{
-			return loco.second;
-		}
-	}
-	return nullptr;
+	return HardwareAddressIndexGet(locosByAddress, GetHardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetLocoName(const LocoID locoID) const
@@ -705,6 +844,11 @@ bool Manager::LocoSave(const LocoID locoID,
 	const Speed travelSpeed,
 	const Speed reducedSpeed,
 	const Speed creepingSpeed,
+	const unsigned int accelerationTime,
+	const unsigned int decelerationTime,
+	const FeedbackID calibrationFeedbackStart,
+	const FeedbackID calibrationFeedbackEnd,
+	const Length calibrationDistance,
 	const std::vector<DataModel::LocoFunctionEntry>& locoFunctions,
 	const std::vector<DataModel::Relation*>& slaves,
 	string& result)
@@ -726,6 +870,8 @@ bool Manager::LocoSave(const LocoID locoID,
 		return false;
 	}
 
+	const HardwareAddressKey oldAddressKey = GetHardwareAddressKey(loco);
+
 	loco->SetName(CheckObjectName(locos, locoMutex, locoID, name.size() == 0 ? "L" : name));
 	loco->SetControlID(controlID);
 	loco->SetProtocol(protocol);
@@ -736,8 +882,15 @@ bool Manager::LocoSave(const LocoID locoID,
 	loco->SetTravelSpeed(travelSpeed);
 	loco->SetReducedSpeed(reducedSpeed);
 	loco->SetCreepingSpeed(creepingSpeed);
+	loco->SetAccelerationTime(accelerationTime);
+	loco->SetDecelerationTime(decelerationTime);
+	loco->SetCalibration(calibrationFeedbackStart, calibrationFeedbackEnd, calibrationDistance);
 	loco->ConfigureFunctions(locoFunctions);
 	loco->AssignSlaves(slaves);
+	{
+		std::lock_guard<std::mutex> guard(locoMutex);
+		HardwareAddressIndexUpdate(locosByAddress, locos, oldAddressKey, loco);
+	}
 
 	// save in db
 	if (storage)
@@ -745,11 +898,11 @@ bool Manager::LocoSave(const LocoID locoID,
 		storage->Save(*loco);
 	}
 	const LocoID locoIdSave = loco->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoSettings(locoIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoSettings(locoIdSave, name);
+		});
 	return true;
 }
 
@@ -778,18 +931,25 @@ bool Manager::LocoDelete(const LocoID locoID, string& result)
 		}
 
 		locos.erase(locoID);
+		HardwareAddressIndexRemove(locosByAddress, locos, GetHardwareAddressKey(loco), loco);
+	}
+	if (speedRamp != nullptr)
+	{
+		speedRamp->Remove(loco);
 	}
+	speedCalibration.Remove(loco);
 
 	if (storage)
 	{
 		storage->DeleteLoco(locoID);
 	}
 	const string& name = loco->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoDelete(locoID, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoDelete(locoID, name);
+		});
+	WaitUntilDispatchedToControls();
 	delete loco;
 	return true;
 }
@@ -842,17 +1002,148 @@ bool Manager::LocoSpeed(const ControlType controlType, Loco* loco, const Speed s
 	{
 		s = MaxSpeed;
 	}
+	// the hardware reports back the steps of a running ramp
+	const bool isHardware = (controlType == ControlTypeHardware);
+	if (isHardware && speedRamp != nullptr && speedRamp->IsEchoOrCancel(loco, s))
+	{
+		return true;
+	}
 	const string& locoName = loco->GetName();
 	logger->Info(Languages::TextLocoSpeedIs, locoName, s);
-	loco->SetSpeed(s, withSlaves);
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	vector<Loco*> slaves;
+	if (withSlaves)
+	{
+		LocoSlaves(loco, slaves);
+	}
+	// a speed reported by the hardware has been reached already
+	if (isHardware == false && speedRamp != nullptr && speedRamp->SetTarget(controlType, loco, slaves, s))
+	{
+		return true;
+	}
+	LocoSpeedImmediately(controlType, loco, slaves, s);
+	return true;
+}
+
+bool Manager::LocoCalibrationStart(const LocoID locoID, string& result)
+{
+	Loco* loco = GetLoco(locoID);
+	if (loco == nullptr)
+	{
+		result = Languages::GetText(Languages::TextLocoDoesNotExist);
+		return false;
+	}
+	// the loco drives round the loop without reserving the tracks
+	{
+		std::lock_guard<std::mutex> guard(locoMutex);
+		for (auto otherLoco : locos)
+		{
+			if (otherLoco.second->IsInAutoMode())
+			{
+				result = Logger::Logger::Format(Languages::GetText(Languages::TextCalibrationLocoInAutoMode), otherLoco.second->GetName());
+				return false;
+			}
+		}
+	}
+	if (loco->IsInUse())
+	{
+		result = Logger::Logger::Format(Languages::GetText(Languages::TextCalibrationNeedsReleasedLoco), loco->GetName());
+		return false;
+	}
+	const FeedbackID start = loco->GetCalibrationFeedbackStart();
+	const FeedbackID end = loco->GetCalibrationFeedbackEnd();
+	if (start == FeedbackNone || end == FeedbackNone || start == end || loco->GetCalibrationDistance() == 0 || loco->GetMaxSpeed() == MinSpeed)
 	{
-		control.second->LocoSpeed(controlType, loco, s);
+		result = Logger::Logger::Format(Languages::GetText(Languages::TextCalibrationNotConfigured), loco->GetName());
+		return false;
+	}
+	if (speedCalibration.Start(loco) == false)
+	{
+		result = Languages::GetText(Languages::TextCalibrationAlreadyRunning);
+		return false;
 	}
+	result = Logger::Logger::Format(Languages::GetText(Languages::TextCalibrationStarted), loco->GetName());
 	return true;
 }
 
+void Manager::LocoCalibrated(Loco* loco, const Loco::SpeedTable& table)
+{
+	loco->SetSpeedTable(table);
+	if (storage)
+	{
+		storage->Save(*loco);
+	}
+	logger->Info(Languages::TextLocoCalibrated, loco->GetName());
+}
+
+void Manager::LocoStopImmediately(const ControlType controlType, Loco* loco, const bool withSlaves)
+{
+	if (loco == nullptr)
+	{
+		return;
+	}
+	logger->Info(Languages::TextLocoSpeedIs, loco->GetName(), MinSpeed);
+	vector<Loco*> slaves;
+	if (withSlaves)
+	{
+		LocoSlaves(loco, slaves);
+	}
+	if (speedRamp != nullptr)
+	{
+		speedRamp->Cancel(loco);
+		for (auto slave : slaves)
+		{
+			speedRamp->Cancel(slave);
+		}
+	}
+	LocoSpeedImmediately(controlType, loco, slaves, MinSpeed);
+}
+
+void Manager::LocoSlaves(const Loco* loco, vector<Loco*>& slaves) const
+{
+	for (auto relation : loco->GetSlaves())
+	{
+		Loco* slave = GetLoco(relation->ObjectID2());
+		if (slave == nullptr)
+		{
+			continue;
+		}
+		slaves.push_back(slave);
+	}
+}
+
+void Manager::LocoSpeedImmediately(const ControlType controlType,
+	Loco* loco,
+	const vector<Loco*>& slaves,
+	const Speed speed)
+{
+	loco->SetSpeed(speed);
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandLocoSpeed, controlType, loco->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->LocoSpeed(controlType, loco, speed);
+		});
+	for (auto slave : slaves)
+	{
+		LocoSpeedImmediately(ControlTypeInternal, slave, vector<Loco*>(), speed);
+	}
+}
+
+void Manager::LocoSpeedRampStep(const vector<SpeedRamp::Step>& steps)
+{
+	for (auto& step : steps)
+	{
+		step.loco->SetSpeed(step.speed);
+	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			for (auto& step : steps)
+			{
+				control->LocoSpeed(step.controlType, step.loco, step.speed);
+			}
+		});
+}
+
 Speed Manager::LocoSpeed(const LocoID locoID) const
 {
 	Loco* loco = GetLoco(locoID);
@@ -887,11 +1178,11 @@ void Manager::LocoOrientation(const ControlType controlType, Loco* loco, const O
 	}
 	loco->SetOrientation(orientation);
 	logger->Info(orientation ? Languages::TextLocoDirectionOfTravelIsRight : Languages::TextLocoDirectionOfTravelIsLeft, loco->GetName());
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoOrientation(controlType, loco, orientation);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandLocoOrientation, controlType, loco->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->LocoOrientation(controlType, loco, orientation);
+		});
 }
 
 void Manager::LocoFunctionState(const ControlType controlType,
@@ -930,11 +1221,11 @@ void Manager::LocoFunctionState(const ControlType controlType,
 
 	loco->SetFunctionState(function, on);
 	logger->Info(on ? Languages::TextLocoFunctionIsOn : Languages::TextLocoFunctionIsOff, loco->GetName(), function);
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoFunction(controlType, loco, function, on);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandLocoFunction, controlType, loco->GetID(), function),
+		[=] (ControlInterface* control)
+		{
+			control->LocoFunction(controlType, loco, function, on);
+		});
 }
 
 /***************************
@@ -991,11 +1282,11 @@ void Manager::AccessoryState(const ControlType controlType, Accessory* accessory
 
 	accessory->SetAccessoryState(state);
 
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessoryState(controlType, accessory);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandAccessoryState, controlType, accessory->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->AccessoryState(controlType, accessory);
+		});
 }
 
 Accessory* Manager::GetAccessory(const AccessoryID accessoryID) const
@@ -1011,16 +1302,7 @@ Accessory* Manager::GetAccessory(const AccessoryID accessoryID) const
 Accessory* Manager::GetAccessory(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(accessoryMutex);
-	for (auto accessory : accessories)
-	{
-		if (accessory.second->GetControlID() == controlID
-			&& accessory.second->GetProtocol() == protocol
-			&& accessory.second->GetAddress() == address)
-		{
-			return accessory.second;
-		}
-	}
-	return nullptr;
+	return HardwareAddressIndexGet(accessoriesByAddress, GetHardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetAccessoryName(const AccessoryID accessoryID) const
@@ -1071,6 +1353,8 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 		return false;
 	}
 
+	const HardwareAddressKey oldAddressKey = GetHardwareAddressKey(accessory);
+
 	// update existing accessory
 	accessory->SetName(CheckObjectName(accessories, accessoryMutex, accessoryID, name.size() == 0 ? "A" : name));
 	accessory->SetPosX(posX);
@@ -1082,6 +1366,11 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 	accessory->SetType(type);
 	accessory->SetAccessoryPulseDuration(duration);
 	accessory->SetInverted(inverted);
+	{
+		std::lock_guard<std::mutex> guard(accessoryMutex);
+		HardwareAddressIndexUpdate(accessoriesByAddress, accessories, oldAddressKey, accessory);
+	}
+	layoutGrid.Update(ObjectTypeAccessory, accessory);
 
 	// save in db
 	if (storage)
@@ -1089,11 +1378,11 @@ bool Manager::AccessorySave(const AccessoryID accessoryID, const string& name, c
 		storage->Save(*accessory);
 	}
 	AccessoryID accessoryIdSave = accessory->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessorySettings(accessoryIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->AccessorySettings(accessoryIdSave, name);
+		});
 	return true;
 }
 
@@ -1134,17 +1423,21 @@ bool Manager::AccessoryDelete(const AccessoryID accessoryID,
 		}
 
 		accessories.erase(accessoryID);
+		layoutGrid.Remove(ObjectTypeAccessory, accessory);
+		HardwareAddressIndexRemove(accessoriesByAddress, accessories, GetHardwareAddressKey(accessory), accessory);
 	}
 
 	if (storage)
 	{
 		storage->DeleteAccessory(accessoryID);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->AccessoryDelete(accessoryID, accessory->GetName());
-	}
+	const string& name = accessory->GetName();
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->AccessoryDelete(accessoryID, name);
+		});
+	WaitUntilDispatchedToControls();
 	delete accessory;
 	return true;
 }
@@ -1157,7 +1450,9 @@ bool Manager::AccessoryRelease(const AccessoryID accessoryID)
 		return false;
 	}
 	LocoID locoID = accessory->GetLoco();
-	return accessory->Release(logger, locoID);
+	bool ret = accessory->Release(logger, locoID);
+	LocoWakeUpAutoModeAll();
+	return ret;
 }
 
 /***************************
@@ -1205,13 +1500,11 @@ void Manager::FeedbackPublishState(const Feedback* feedback)
 	const string& feedbackName = feedback->GetName();
 	logger->Info(state ? Languages::TextFeedbackStateIsOn : Languages::TextFeedbackStateIsOff, feedbackName);
 	const FeedbackID feedbackID = feedback->GetID();
-	{
-		std::lock_guard<std::mutex> guard(controlMutex);
-		for (auto control : controls)
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandFeedbackState, ControlTypeInternal, feedbackID),
+		[=] (ControlInterface* control)
 		{
-			control.second->FeedbackState(feedbackName, feedbackID, state);
-		}
-	}
+			control->FeedbackState(feedbackName, feedbackID, state);
+		});
 }
 
 Feedback* Manager::GetFeedback(const FeedbackID feedbackID) const
@@ -1232,6 +1525,16 @@ Feedback* Manager::GetFeedbackUnlocked(const FeedbackID feedbackID) const
 Feedback* Manager::GetFeedback(const ControlID controlID, const FeedbackPin pin) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
+	if (pin <= MaxFeedbackPinTable)
+	{
+		const std::vector<Feedback*>& feedbackPinTable = feedbacksByPin[controlID];
+		if (pin >= feedbackPinTable.size())
+		{
+			return nullptr;
+		}
+		return feedbackPinTable[pin];
+	}
+
 	for (auto feedback : feedbacks)
 	{
 		if (feedback.second->GetControlID() == controlID
@@ -1243,6 +1546,33 @@ Feedback* Manager::GetFeedback(const ControlID controlID, const FeedbackPin pin)
 	return nullptr;
 }
 
+void Manager::FeedbackPinTableBuild(const ControlID controlID)
+{
+	std::vector<Feedback*>& feedbackPinTable = feedbacksByPin[controlID];
+	feedbackPinTable.clear();
+	for (auto feedback : feedbacks)
+	{
+		if (feedback.second->GetControlID() != controlID)
+		{
+			continue;
+		}
+		const FeedbackPin pin = feedback.second->GetPin();
+		if (pin > MaxFeedbackPinTable)
+		{
+			continue;
+		}
+		if (pin >= feedbackPinTable.size())
+		{
+			feedbackPinTable.resize(pin + 1, nullptr);
+		}
+		// like a search through feedbacks the feedback with the lowest ID wins
+		if (feedbackPinTable[pin] == nullptr)
+		{
+			feedbackPinTable[pin] = feedback.second;
+		}
+	}
+}
+
 const std::string& Manager::GetFeedbackName(const FeedbackID feedbackID) const
 {
 	std::lock_guard<std::mutex> guard(feedbackMutex);
@@ -1291,6 +1621,8 @@ FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string&
 		return false;
 	}
 
+	const ControlID oldControlID = feedback->GetControlID();
+
 	feedback->SetName(CheckObjectName(feedbacks, feedbackMutex, feedbackID, name.size() == 0 ? "F" : name));
 	feedback->SetVisible(visible);
 	feedback->SetPosX(posX);
@@ -1299,6 +1631,15 @@ FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string&
 	feedback->SetControlID(controlID);
 	feedback->SetPin(pin);
 	feedback->SetInverted(inverted);
+	{
+		std::lock_guard<std::mutex> guard(feedbackMutex);
+		FeedbackPinTableBuild(oldControlID);
+		if (oldControlID != controlID)
+		{
+			FeedbackPinTableBuild(controlID);
+		}
+	}
+	layoutGrid.Update(ObjectTypeFeedback, feedback);
 
 	// save in db
 	if (storage)
@@ -1306,11 +1647,11 @@ FeedbackID Manager::FeedbackSave(const FeedbackID feedbackID, const std::string&
 		storage->Save(*feedback);
 	}
 	FeedbackID feedbackIdSave = feedback->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->FeedbackSettings(feedbackIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->FeedbackSettings(feedbackIdSave, name);
+		});
 	return feedbackIdSave;
 }
 
@@ -1367,6 +1708,8 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 		}
 
 		feedbacks.erase(feedbackID);
+		layoutGrid.Remove(ObjectTypeFeedback, feedback);
+		FeedbackPinTableBuild(feedback->GetControlID());
 	}
 
 	if (storage)
@@ -1374,11 +1717,11 @@ bool Manager::FeedbackDelete(const FeedbackID feedbackID,
 		storage->DeleteFeedback(feedbackID);
 	}
 	const string& name = feedback->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->FeedbackDelete(feedbackID, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->FeedbackDelete(feedbackID, name);
+		});
 	delete feedback;
 	return true;
 }
@@ -1606,18 +1949,20 @@ TrackID Manager::TrackSave(const TrackID trackID,
 	track->SetSelectRouteApproach(selectRouteApproach);
 	track->SetAllowLocoTurn(allowLocoTurn);
 	track->SetReleaseWhenFree(releaseWhenFree);
+	routePlanner.TrackBaseChanged(ObjectIdentifier(ObjectTypeTrack, track->GetID()));
+	layoutGrid.Update(ObjectTypeTrack, track);
 
 	// save in db
 	if (storage)
 	{
 		storage->Save(*track);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
 	TrackID trackIdSave = track->GetID();
-	for (auto control : controls)
-	{
-		control.second->TrackSettings(trackIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->TrackSettings(trackIdSave, name);
+		});
 	return trackIdSave;
 }
 
@@ -1674,6 +2019,7 @@ bool Manager::TrackDelete(const TrackID trackID,
 		}
 
 		tracks.erase(trackID);
+		layoutGrid.Remove(ObjectTypeTrack, track);
 	}
 
 	if (storage)
@@ -1681,11 +2027,11 @@ bool Manager::TrackDelete(const TrackID trackID,
 		storage->DeleteTrack(trackID);
 	}
 	const string& name = track->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->TrackDelete(trackID, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->TrackDelete(trackID, name);
+		});
 
 	Cluster* cluster = track->GetCluster();
 	if (cluster != nullptr)
@@ -1693,6 +2039,7 @@ bool Manager::TrackDelete(const TrackID trackID,
 		cluster->DeleteTrack(track);
 	}
 
+	WaitUntilDispatchedToControls();
 	delete track;
 	return true;
 }
@@ -1728,11 +2075,11 @@ void Manager::SwitchState(const ControlType controlType, Switch* mySwitch, const
 
 	mySwitch->SetAccessoryState(state);
 
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchState(controlType, mySwitch);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandSwitchState, controlType, mySwitch->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->SwitchState(controlType, mySwitch);
+		});
 }
 
 Switch* Manager::GetSwitch(const SwitchID switchID) const
@@ -1748,16 +2095,7 @@ Switch* Manager::GetSwitch(const SwitchID switchID) const
 Switch* Manager::GetSwitch(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(switchMutex);
-	for (auto mySwitch : switches)
-	{
-		if (mySwitch.second->GetControlID() == controlID
-			&& mySwitch.second->GetProtocol() == protocol
-			&& mySwitch.second->GetAddress() == address)
-		{
-			return mySwitch.second;
-		}
-	}
-	return nullptr;
+	return HardwareAddressIndexGet(switchesByAddress, GetHardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetSwitchName(const SwitchID switchID) const
@@ -1818,6 +2156,8 @@ bool Manager::SwitchSave(const SwitchID switchID,
 		return false;
 	}
 
+	const HardwareAddressKey oldAddressKey = GetHardwareAddressKey(mySwitch);
+
 	// update existing switch
 	mySwitch->SetName(CheckObjectName(switches, switchMutex, switchID, name.size() == 0 ? "S" : name));
 	mySwitch->SetPosX(posX);
@@ -1830,6 +2170,11 @@ bool Manager::SwitchSave(const SwitchID switchID,
 	mySwitch->SetType(type);
 	mySwitch->SetAccessoryPulseDuration(duration);
 	mySwitch->SetInverted(inverted);
+	{
+		std::lock_guard<std::mutex> guard(switchMutex);
+		HardwareAddressIndexUpdate(switchesByAddress, switches, oldAddressKey, mySwitch);
+	}
+	layoutGrid.Update(ObjectTypeSwitch, mySwitch);
 
 	// save in db
 	if (storage)
@@ -1837,11 +2182,11 @@ bool Manager::SwitchSave(const SwitchID switchID,
 		storage->Save(*mySwitch);
 	}
 	const SwitchID switchIdSave = mySwitch->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchSettings(switchIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->SwitchSettings(switchIdSave, name);
+		});
 	return true;
 }
 
@@ -1870,6 +2215,8 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 			return false;
 		}
 		switches.erase(switchID);
+		layoutGrid.Remove(ObjectTypeSwitch, mySwitch);
+		HardwareAddressIndexRemove(switchesByAddress, switches, GetHardwareAddressKey(mySwitch), mySwitch);
 	}
 
 	if (storage)
@@ -1878,11 +2225,12 @@ bool Manager::SwitchDelete(const SwitchID switchID,
 	}
 
 	const string& switchName = mySwitch->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SwitchDelete(switchID, switchName);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->SwitchDelete(switchID, switchName);
+		});
+	WaitUntilDispatchedToControls();
 	delete mySwitch;
 	return true;
 }
@@ -1906,7 +2254,9 @@ bool Manager::SwitchRelease(const RouteID switchID)
 		return false;
 	}
 	LocoID locoID = mySwitch->GetLoco();
-	return mySwitch->Release(logger, locoID);
+	bool ret = mySwitch->Release(logger, locoID);
+	LocoWakeUpAutoModeAll();
+	return ret;
 }
 
 /***************************
@@ -2018,6 +2368,7 @@ bool Manager::RouteSave(const RouteID routeID,
 	// remove route from old track
 	ObjectIdentifier oldFromTrack = route->GetFromTrack();
 	TrackBase* oldTrack = GetTrackBase(oldFromTrack);
+	routePlanner.TrackBaseChanged(oldFromTrack);
 	if (oldTrack != nullptr)
 	{
 		oldTrack->RemoveRoute(route);
@@ -2085,6 +2436,7 @@ bool Manager::RouteSave(const RouteID routeID,
 	//Add new route
 	ObjectIdentifier newFromTrack = route->GetFromTrack();
 	TrackBase* newTrack = GetTrackBase(newFromTrack);
+	routePlanner.TrackBaseChanged(newFromTrack);
 	if (newTrack != nullptr)
 	{
 		newTrack->AddRoute(route);
@@ -2106,16 +2458,21 @@ bool Manager::RouteSave(const RouteID routeID,
 		}
 	}
 
+	RouteConflictsUpdate(route);
+	routeUsage.Update(route);
+	layoutGrid.Update(ObjectTypeRoute, route);
+
 	// save in db
 	if (storage)
 	{
 		storage->Save(*route);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->RouteSettings(route->GetID(), name);
-	}
+	const RouteID routeIdSave = route->GetID();
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->RouteSettings(routeIdSave, name);
+		});
 	return true;
 }
 
@@ -2167,7 +2524,17 @@ bool Manager::RouteDelete(const RouteID routeID,
 		{
 			std::lock_guard<std::mutex> guard(routeMutex);
 			routes.erase(routeID);
+			layoutGrid.Remove(ObjectTypeRoute, route);
+			routePlanner.TrackBaseChanged(route->GetFromTrack());
 		}
+		routeConflicts.Remove(routeID);
+		routeUsage.Remove(routeID);
+	}
+
+	TrackBase* fromTrack = GetTrackBase(route->GetFromTrack());
+	if (fromTrack != nullptr)
+	{
+		fromTrack->RemoveRoute(route);
 	}
 
 	if (storage)
@@ -2176,26 +2543,104 @@ bool Manager::RouteDelete(const RouteID routeID,
 	}
 
 	const string& routeName = route->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->RouteDelete(routeID, routeName);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->RouteDelete(routeID, routeName);
+		});
+	WaitUntilDispatchedToControls();
 	delete route;
 	return true;
 }
 
-Route* Manager::GetFirstRouteToTrackBase(const ObjectIdentifier& identifier) const
+bool Manager::RoutePlan(const LocoID locoID,
+	const ObjectIdentifier& to,
+	vector<Route*>& path)
 {
-	std::lock_guard<std::mutex> guard(routeMutex);
-	for (auto route : routes)
+	path.clear();
+	const Loco* loco = GetLoco(locoID);
+	if (loco == nullptr)
 	{
-		if (route.second->GetToTrack() == identifier)
+		return false;
+	}
+	ObjectIdentifier from;
+	Orientation fromOrientation;
+	if (loco->GetTrack(from, fromOrientation) == false)
+	{
+		logger->Info(Languages::TextRoutePlanNotOnTrack, loco->GetName());
+		return false;
+	}
+
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	// the tracks are read before routeMutex is taken, the track and signal mutexes must not be nested in it
+	RoutePlanner::TrackSet turnTracks;
+	{
+		std::lock_guard<std::mutex> guard(trackMutex);
+		for (auto& track : tracks)
 		{
-			return route.second;
+			if (track.second->GetAllowLocoTurn())
+			{
+				turnTracks.insert(RoutePlanner::GetTrackKey(ObjectIdentifier(ObjectTypeTrack, track.first)));
+			}
 		}
 	}
-	return nullptr;
+	{
+		std::lock_guard<std::mutex> guard(signalMutex);
+		for (auto& signal : signals)
+		{
+			if (signal.second->GetAllowLocoTurn())
+			{
+				turnTracks.insert(RoutePlanner::GetTrackKey(ObjectIdentifier(ObjectTypeSignal, signal.first)));
+			}
+		}
+	}
+	bool ret;
+	{
+		std::lock_guard<std::mutex> guard(routeMutex);
+		ret = routePlanner.Plan(routes, turnTracks, from, fromOrientation, to, loco->GetPushpull(), loco->GetLength(), true, path);
+	}
+	const unsigned int planTime = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	logger->Debug(Languages::TextRoutePlanTime, loco->GetName(), planTime);
+	if (planTime > static_cast<unsigned int>(RoutePlanMaxTime))
+	{
+		logger->Warning(Languages::TextRoutePlanSlow, loco->GetName(), planTime, static_cast<unsigned int>(RoutePlanMaxTime));
+	}
+	return ret;
+}
+
+void Manager::RouteConflictsUpdate(const Route* route)
+{
+	vector<ObjectIdentifier> objects;
+	route->GetLockedObjects(objects);
+	routeConflicts.Update(route->GetID(), objects);
+}
+
+void Manager::RouteGetConflictFree(const LocoID locoID, RouteConflictMatrix::Bitset& freeRoutes) const
+{
+	vector<RouteID> busyRoutes;
+	{
+		std::lock_guard<std::mutex> guard(routeMutex);
+		for (auto route : routes)
+		{
+			const LocoID routeLocoID = route.second->GetLoco();
+			if (routeLocoID == LocoNone || routeLocoID == locoID)
+			{
+				continue;
+			}
+			busyRoutes.push_back(route.first);
+		}
+	}
+	routeConflicts.GetFreeRoutes(busyRoutes, freeRoutes);
+}
+
+Route* Manager::GetFirstRouteToTrackBase(const ObjectIdentifier& identifier) const
+{
+	const RouteID routeID = routeUsage.GetFirstRoute(identifier, RouteUsageIndex::UsageDestination);
+	if (routeID == RouteNone)
+	{
+		return nullptr;
+	}
+	return GetRoute(routeID);
 }
 
 Layer* Manager::GetLayer(const LayerID layerID) const
@@ -2257,11 +2702,11 @@ bool Manager::LayerSave(const LayerID layerID, const std::string&name, std::stri
 		storage->Save(*layer);
 	}
 	const LayerID layerIdSave = layer->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LayerSettings(layerIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LayerSettings(layerIdSave, name);
+		});
 	return true;
 }
 
@@ -2365,11 +2810,11 @@ bool Manager::LayerDelete(const LayerID layerID,
 	}
 
 	const string& layerName = layer->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LayerDelete(layerID, layerName);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LayerDelete(layerID, layerName);
+		});
 	delete layer;
 	return true;
 }
@@ -2413,11 +2858,11 @@ bool Manager::SignalState(const ControlType controlType, Signal* signal, const D
 
 void Manager::SignalPublishState(const ControlType controlType, const DataModel::Signal* signal)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalState(controlType, signal);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandSignalState, controlType, signal->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->SignalState(controlType, signal);
+		});
 }
 
 Signal* Manager::GetSignal(const SignalID signalID) const
@@ -2433,16 +2878,7 @@ Signal* Manager::GetSignal(const SignalID signalID) const
 Signal* Manager::GetSignal(const ControlID controlID, const Protocol protocol, const Address address) const
 {
 	std::lock_guard<std::mutex> guard(signalMutex);
-	for (auto signal : signals)
-	{
-		if (signal.second->GetControlID() == controlID
-			&& signal.second->GetProtocol() == protocol
-			&& signal.second->GetAddress() == address)
-		{
-			return signal.second;
-		}
-	}
-	return nullptr;
+	return HardwareAddressIndexGet(signalsByAddress, GetHardwareAddressKey(controlID, protocol, address));
 }
 
 const std::string& Manager::GetSignalName(const SignalID signalID) const
@@ -2511,6 +2947,8 @@ bool Manager::SignalSave(const SignalID signalID,
 		return false;
 	}
 
+	const HardwareAddressKey oldAddressKey = GetHardwareAddressKey(signal);
+
 	signal->SetName(CheckObjectName(signals, signalMutex, signalID, name.size() == 0 ? "S" : name));
 	signal->SetSignalOrientation(signalOrientation);
 	signal->SetPosX(posX);
@@ -2522,12 +2960,18 @@ bool Manager::SignalSave(const SignalID signalID,
 	signal->SetSelectRouteApproach(selectRouteApproach);
 	signal->SetAllowLocoTurn(allowLocoTurn);
 	signal->SetReleaseWhenFree(releaseWhenFree);
+	routePlanner.TrackBaseChanged(ObjectIdentifier(ObjectTypeSignal, signal->GetID()));
 	signal->SetControlID(controlID);
 	signal->SetProtocol(protocol);
 	signal->SetAddress(address);
 	signal->SetType(type);
 	signal->SetAccessoryPulseDuration(duration);
 	signal->SetInverted(inverted);
+	{
+		std::lock_guard<std::mutex> guard(signalMutex);
+		HardwareAddressIndexUpdate(signalsByAddress, signals, oldAddressKey, signal);
+	}
+	layoutGrid.Update(ObjectTypeSignal, signal);
 
 	// save in db
 	if (storage)
@@ -2535,11 +2979,11 @@ bool Manager::SignalSave(const SignalID signalID,
 		storage->Save(*signal);
 	}
 	const SignalID signalIdSave = signal->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalSettings(signalIdSave, name);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->SignalSettings(signalIdSave, name);
+		});
 	return true;
 }
 
@@ -2597,6 +3041,8 @@ bool Manager::SignalDelete(const SignalID signalID,
 
 		signal = signals.at(signalID);
 		signals.erase(signalID);
+		layoutGrid.Remove(ObjectTypeSignal, signal);
+		HardwareAddressIndexRemove(signalsByAddress, signals, GetHardwareAddressKey(signal), signal);
 	}
 
 	if (storage)
@@ -2605,11 +3051,11 @@ bool Manager::SignalDelete(const SignalID signalID,
 	}
 
 	const string& signalName = signal->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->SignalDelete(signalID, signalName);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->SignalDelete(signalID, signalName);
+		});
 
 	Cluster* cluster = signal->GetCluster();
 	if (cluster != nullptr)
@@ -2617,6 +3063,7 @@ bool Manager::SignalDelete(const SignalID signalID,
 		cluster->DeleteSignal(signal);
 	}
 
+	WaitUntilDispatchedToControls();
 	delete signal;
 	return true;
 }
@@ -2715,11 +3162,11 @@ bool Manager::ClusterDelete(const ClusterID clusterID)
 	}
 
 	const string& clusterName = cluster->GetName();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->ClusterDelete(clusterID, clusterName);
-	}
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->ClusterDelete(clusterID, clusterName);
+		});
 	delete cluster;
 	return true;
 }
@@ -2783,7 +3230,7 @@ bool Manager::LocoRelease(const LocoID locoID)
 
 bool Manager::LocoReleaseInternal(Loco* loco)
 {
-	LocoSpeed(ControlTypeInternal, loco, MinSpeed);
+	LocoStopImmediately(ControlTypeInternal, loco);
 
 	bool ret = loco->Release();
 	if (ret == false)
@@ -2791,12 +3238,216 @@ bool Manager::LocoReleaseInternal(Loco* loco)
 		return false;
 	}
 	LocoID locoID = loco->GetID();
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoRelease(locoID);
+		});
+	LocoWakeUpAutoModeAll();
+	return true;
+}
+
+void Manager::LocoWakeUpAutoModeAll() const
+{
+	std::lock_guard<std::mutex> guard(locoMutex);
+	for (auto loco : locos)
 	{
-		control.second->LocoRelease(locoID);
+		if (loco.second->IsInAutoMode() == false)
+		{
+			continue;
+		}
+		loco.second->WakeUpAutoMode();
 	}
-	return true;
+}
+
+void Manager::LocoWaitsFor(const LocoID locoID, const vector<vector<LocoID>>& blockingLocos)
+{
+	std::lock_guard<std::mutex> guard(waitForMutex);
+	if (blockingLocos.empty())
+	{
+		waitFor.erase(locoID);
+		deadlockedLocos.erase(std::remove(deadlockedLocos.begin(), deadlockedLocos.end(), locoID), deadlockedLocos.end());
+		return;
+	}
+	waitFor[locoID] = blockingLocos;
+
+	// a cycle alone is no deadlock, every loco in it may leave through another route.
+	// Collect all locos the loco waits for directly or indirectly.
+	vector<LocoID> reachable;
+	reachable.push_back(locoID);
+	for (size_t index = 0; index < reachable.size(); ++index)
+	{
+		auto edges = waitFor.find(reachable[index]);
+		if (edges == waitFor.end())
+		{
+			continue;
+		}
+		for (auto& route : edges->second)
+		{
+			for (auto blocker : route)
+			{
+				if (std::find(reachable.begin(), reachable.end(), blocker) != reachable.end())
+				{
+					continue;
+				}
+				reachable.push_back(blocker);
+			}
+		}
+	}
+
+	// a loco that does not wait can move, a waiting loco can move as soon as all locos of one
+	// of its routes can move. What can not move in the end is deadlocked.
+	vector<LocoID> canMove;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto loco : reachable)
+		{
+			if (std::find(canMove.begin(), canMove.end(), loco) != canMove.end())
+			{
+				continue;
+			}
+			auto edges = waitFor.find(loco);
+			bool free = (edges == waitFor.end());
+			for (size_t route = 0; free == false && route < edges->second.size(); ++route)
+			{
+				free = true;
+				for (auto blocker : edges->second[route])
+				{
+					if (std::find(canMove.begin(), canMove.end(), blocker) == canMove.end())
+					{
+						free = false;
+						break;
+					}
+				}
+			}
+			if (free == false)
+			{
+				continue;
+			}
+			canMove.push_back(loco);
+			changed = true;
+		}
+	}
+	if (std::find(canMove.begin(), canMove.end(), locoID) != canMove.end())
+	{
+		return;
+	}
+
+	// report every deadlock only once
+	bool isNew = false;
+	string locos;
+	for (auto loco : reachable)
+	{
+		if (std::find(canMove.begin(), canMove.end(), loco) != canMove.end())
+		{
+			continue;
+		}
+		if (locos.empty() == false)
+		{
+			locos += ", ";
+		}
+		locos += GetLocoName(loco);
+		if (std::find(deadlockedLocos.begin(), deadlockedLocos.end(), loco) != deadlockedLocos.end())
+		{
+			continue;
+		}
+		deadlockedLocos.push_back(loco);
+		isNew = true;
+	}
+	if (isNew == false)
+	{
+		return;
+	}
+	++deadlocksDetected;
+	logger->Warning(Languages::TextDeadlockDetected, locos);
+}
+
+bool Manager::LocoCanLeaveTrackBase(Logger::Logger* logger,
+	const Loco* loco,
+	const TrackBase* track,
+	const Orientation orientation,
+	vector<LocoID>& visitedLocos,
+	const unsigned int depth) const
+{
+	// only exits that lead into a loop of waiting locos are closed,
+	// blocked or occupied tracks without a loco are expected to get free again
+	vector<Route*> exits;
+	track->GetValidRoutes(logger, loco, orientation, true, exits);
+	if (exits.empty())
+	{
+		return true;
+	}
+	for (auto exit : exits)
+	{
+		const TrackBase* destination = GetTrackBase(exit->GetToTrack());
+		if (destination == nullptr)
+		{
+			continue;
+		}
+		LocoID holder = destination->GetLocoDelayed();
+		if (holder == LocoNone)
+		{
+			holder = destination->GetMyLoco();
+		}
+		if (holder == LocoNone)
+		{
+			return true;
+		}
+		if (holder == loco->GetID())
+		{
+			return true;
+		}
+		if (std::find(visitedLocos.begin(), visitedLocos.end(), holder) != visitedLocos.end())
+		{
+			// the holder is waiting for a loco that is checked already
+			continue;
+		}
+		const Loco* holderLoco = GetLoco(holder);
+		if (holderLoco == nullptr || holderLoco->IsInAutoMode() == false || depth == 0)
+		{
+			// a loco in manual mode can be moved away by the user
+			return true;
+		}
+		visitedLocos.push_back(holder);
+		if (LocoCanLeaveTrackBase(logger, holderLoco, destination, destination->GetLocoOrientation(), visitedLocos, depth - 1))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void Manager::LocoDeadlockAvoided()
+{
+	std::lock_guard<std::mutex> guard(waitForMutex);
+	++deadlocksAvoided;
+}
+
+void Manager::GetDeadlockStatistics(uint64_t& detected, uint64_t& avoided) const
+{
+	std::lock_guard<std::mutex> guard(waitForMutex);
+	detected = deadlocksDetected;
+	avoided = deadlocksAvoided;
+}
+
+void Manager::LocoAutoModeWakeUp(Loco* loco) const
+{
+	if (autoModeScheduler == nullptr)
+	{
+		return;
+	}
+	autoModeScheduler->WakeUp(loco);
+}
+
+void Manager::LocoAutoModeRemove(Loco* loco) const
+{
+	if (autoModeScheduler == nullptr)
+	{
+		return;
+	}
+	autoModeScheduler->Remove(loco);
 }
 
 bool Manager::TrackBaseRelease(const ObjectIdentifier& identifier)
@@ -2806,7 +3457,9 @@ bool Manager::TrackBaseRelease(const ObjectIdentifier& identifier)
 	{
 		return false;
 	}
-	return track->BaseReleaseForce(logger, LocoNone);
+	bool ret = track->BaseReleaseForce(logger, LocoNone);
+	LocoWakeUpAutoModeAll();
+	return ret;
 }
 
 bool Manager::LocoReleaseOnTrackBase(const ObjectIdentifier& identifier)
@@ -2887,11 +3540,11 @@ void Manager::TrackBasePublishState(const DataModel::TrackBase* trackBase)
 
 void Manager::TrackPublishState(const DataModel::Track* track)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->TrackState(track);
-	}
+	DispatchToControls(ControlDispatcher::GetKey(ControlDispatcher::CommandTrackState, ControlTypeInternal, track->GetID()),
+		[=] (ControlInterface* control)
+		{
+			control->TrackState(track);
+		});
 }
 
 bool Manager::RouteRelease(const RouteID routeID)
@@ -2902,16 +3555,50 @@ bool Manager::RouteRelease(const RouteID routeID)
 		return false;
 	}
 	LocoID locoID = route->GetLoco();
-	return route->Release(logger, locoID);
+	bool ret = route->Release(logger, locoID);
+	LocoWakeUpAutoModeAll();
+	return ret;
 }
 
-bool Manager::LocoDestinationReached(const Loco* loco, const Route* route, const TrackBase* track)
+bool Manager::RouteReserveAndLock(Logger::Logger* logger, Route* route, const LocoID locoID)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	std::unique_lock<std::mutex> lock(reservationMutex, std::try_to_lock);
+	if (lock.owns_lock() == false)
+	{
+		lock.lock();
+		++reservationsContended;
+	}
+
+	// a route that is not free must not be touched, a rollback would execute the unlock relations
+	if (route->CanReserveAndLock(locoID) == false)
+	{
+		++reservationsRejected;
+		return false;
+	}
+
+	// reservations and locks outside of a transaction (manual operation) can still interfere
+	if (route->Reserve(logger, locoID) == false)
 	{
-		control.second->LocoDestinationReached(loco, route, track);
+		++reservationsRolledBack;
+		return false;
+	}
+	if (route->Lock(logger, locoID) == false)
+	{
+		route->Release(logger, locoID);
+		++reservationsRolledBack;
+		return false;
 	}
+	++reservationsCommitted;
+	return true;
+}
+
+bool Manager::LocoDestinationReached(const Loco* loco, const Route* route, const TrackBase* track)
+{
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoDestinationReached(loco, route, track);
+		});
 	return true;
 }
 
@@ -2922,21 +3609,33 @@ bool Manager::LocoStart(const LocoID locoID)
 	{
 		return false;
 	}
-	bool ret = loco->GoToAutoMode();
-	if (ret == false)
+	// the calibrated loco drives without reserving its tracks
+	if (speedCalibration.IsRunning())
 	{
+		logger->Warning(Languages::TextCalibrationRunningNoAutoMode);
 		return false;
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	bool ret = loco->GoToAutoMode();
+	if (ret == false)
 	{
-		control.second->LocoStart(locoID, loco->GetName());
+		return false;
 	}
+	const string& name = loco->GetName();
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoStart(locoID, name);
+		});
 	return true;
 }
 
 bool Manager::LocoStartAll()
 {
+	if (speedCalibration.IsRunning())
+	{
+		logger->Warning(Languages::TextCalibrationRunningNoAutoMode);
+		return false;
+	}
 	std::lock_guard<std::mutex> guard(locoMutex);
 	for (auto loco : locos)
 	{
@@ -2945,13 +3644,13 @@ bool Manager::LocoStartAll()
 		{
 			continue;
 		}
-		{
-			std::lock_guard<std::mutex> guard(controlMutex);
-			for (auto control : controls)
+		const LocoID locoID = loco.first;
+		const string& name = loco.second->GetName();
+		DispatchToControls(ControlDispatcher::KeyNone,
+			[=] (ControlInterface* control)
 			{
-				control.second->LocoStart(loco.first, loco.second->GetName());
-			}
-		}
+				control->LocoStart(locoID, name);
+			});
 	}
 	return true;
 }
@@ -2972,11 +3671,12 @@ bool Manager::LocoStop(const LocoID locoID)
 	{
 		Utils::Utils::SleepForSeconds(1);
 	}
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
-	{
-		control.second->LocoStop(locoID, loco->GetName());
-	}
+	const string& name = loco->GetName();
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->LocoStop(locoID, name);
+		});
 	return true;
 }
 
@@ -3009,12 +3709,13 @@ bool Manager::LocoStopAll()
 			anyLocosInAutoMode |= !locoInManualMode;
 			if (locoInManualMode)
 			{
+				const LocoID locoID = loco.first;
 				const string& locoName = loco.second->GetName();
-				std::lock_guard<std::mutex> guard(controlMutex);
-				for (auto control : controls)
-				{
-					control.second->LocoStop(loco.first, locoName);
-				}
+				DispatchToControls(ControlDispatcher::KeyNone,
+					[=] (ControlInterface* control)
+					{
+						control->LocoStop(locoID, locoName);
+					});
 			}
 		}
 	}
@@ -3026,7 +3727,7 @@ void Manager::StopAllLocosImmediately(const ControlType controlType)
 	std::lock_guard<std::mutex> guard(locoMutex);
 	for (auto loco : locos)
 	{
-		LocoSpeed(controlType, loco.second, MinSpeed, false);
+		LocoStopImmediately(controlType, loco.second, false);
 	}
 }
 
@@ -3036,12 +3737,7 @@ void Manager::StopAllLocosImmediately(const ControlType controlType)
 
 bool Manager::CheckPositionFree(const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, string& result) const
 {
-	return CheckLayoutPositionFree(posX, posY, posZ, result, accessories, accessoryMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, tracks, trackMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, feedbacks, feedbackMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, switches, switchMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, routes, routeMutex)
-		&& CheckLayoutPositionFree(posX, posY, posZ, result, signals, signalMutex);
+	return layoutGrid.CheckPositionFree(posX, posY, posZ, result);
 }
 
 bool Manager::CheckPositionFree(const LayoutPosition posX,
@@ -3086,22 +3782,6 @@ bool Manager::CheckPositionFree(const LayoutPosition posX,
 	return true;
 }
 
-template<class Type>
-bool Manager::CheckLayoutPositionFree(const LayoutPosition posX, const LayoutPosition posY, const LayoutPosition posZ, string& result, const map<ObjectID, Type*>& layoutVector, std::mutex& mutex) const
-{
-	std::lock_guard<std::mutex> guard(mutex);
-	for (auto layout : layoutVector)
-	{
-		if (layout.second->CheckPositionFree(posX, posY, posZ))
-		{
-			continue;
-		}
-		result.assign(Logger::Logger::Format(Languages::GetText(Languages::TextPositionAlreadyInUse), static_cast<int>(posX), static_cast<int>(posY), static_cast<int>(posZ), layout.second->GetLayoutType(), layout.second->GetName()));
-		return false;
-	}
-	return true;
-}
-
 bool Manager::CheckAddressLoco(const Protocol protocol, const Address address, string& result)
 {
 	switch (protocol)
@@ -3223,6 +3903,7 @@ bool Manager::SaveSettings(const Languages::Language language,
 	const DataModel::AccessoryPulseDuration duration,
 	const bool autoAddFeedback,
 	const bool stopOnFeedbackInFreeTrack,
+	const bool executeRoutesInBatches,
 	const DataModel::SelectRouteApproach selectRouteApproach,
 	const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve,
 	const Logger::Logger::Level logLevel
@@ -3232,8 +3913,9 @@ bool Manager::SaveSettings(const Languages::Language language,
 	this->defaultAccessoryDuration = duration;
 	this->autoAddFeedback = autoAddFeedback;
 	this->stopOnFeedbackInFreeTrack = stopOnFeedbackInFreeTrack;
+	this->executeRoutesInBatches = executeRoutesInBatches;
 	this->selectRouteApproach = selectRouteApproach;
-	this->nrOfTracksToReserve = nrOfTracksToReserve;
+	this->nrOfTracksToReserve = CheckNrOfTracksToReserve(nrOfTracksToReserve);
 	Logger::Logger::SetLogLevel(logLevel);
 
 	if (storage == nullptr)
@@ -3244,43 +3926,100 @@ bool Manager::SaveSettings(const Languages::Language language,
 	storage->SaveSetting("DefaultAccessoryDuration", std::to_string(duration));
 	storage->SaveSetting("AutoAddFeedback", std::to_string(autoAddFeedback));
 	storage->SaveSetting("StopOnFeedbackInFreeTrack", std::to_string(stopOnFeedbackInFreeTrack));
+	storage->SaveSetting("ExecuteRoutesInBatches", std::to_string(executeRoutesInBatches));
 	storage->SaveSetting("SelectRouteApproach", std::to_string(static_cast<int>(selectRouteApproach)));
-	storage->SaveSetting("NrOfTracksToReserve", std::to_string(static_cast<int>(nrOfTracksToReserve)));
+	storage->SaveSetting("NrOfTracksToReserve", std::to_string(static_cast<int>(this->nrOfTracksToReserve)));
 	storage->SaveSetting("LogLevel", std::to_string(static_cast<int>(logLevel)));
 	return true;
 }
 
+void Manager::FeedbackDebounceStart(const FeedbackID feedbackID, const std::chrono::steady_clock::time_point deadline)
+{
+	{
+		std::lock_guard<std::mutex> guard(debounceMutex);
+		if (debounceWheel.IsEmpty())
+		{
+			debounceWheel.SetCurrentTick(GetDebounceTick(std::chrono::steady_clock::now(), false));
+		}
+		debounceWheel.Add(feedbackID, GetDebounceTick(deadline, true));
+	}
+	debounceCondition.notify_one();
+}
+
+Utils::TimerWheel::Tick Manager::GetDebounceTick(const std::chrono::steady_clock::time_point time, const bool roundUp) const
+{
+	const std::chrono::steady_clock::duration sinceEpoch = time - debounceEpoch;
+	Utils::TimerWheel::Tick tick = static_cast<Utils::TimerWheel::Tick>(sinceEpoch / debounceResolution);
+	if (roundUp && sinceEpoch % debounceResolution != std::chrono::steady_clock::duration::zero())
+	{
+		++tick;
+	}
+	return tick;
+}
+
 void Manager::DebounceWorker()
 {
 	Utils::Utils::SetThreadName(Languages::GetText(Languages::TextDebouncer));
 	logger->Info(Languages::TextDebounceThreadStarted);
+	std::vector<Utils::TimerWheel::TimerID> expired;
+	std::unique_lock<std::mutex> lock(debounceMutex);
 	while (debounceRun)
 	{
+		// the thread only wakes up periodically as long as feedbacks are falling
+		if (debounceWheel.IsEmpty())
+		{
+			debounceCondition.wait(lock);
+			continue;
+		}
+		debounceCondition.wait_for(lock, debounceResolution);
+
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		debounceWheel.Advance(GetDebounceTick(now, false), expired);
+		if (expired.empty())
+		{
+			continue;
+		}
+
+		lock.unlock();
 		{
 			std::lock_guard<std::mutex> guard(feedbackMutex);
-			for (auto feedback : feedbacks)
+			for (auto feedbackID : expired)
 			{
-				feedback.second->Debounce();
+				Feedback* feedback = GetFeedbackUnlocked(feedbackID);
+				if (feedback == nullptr)
+				{
+					continue;
+				}
+				std::chrono::microseconds latency;
+				if (feedback->Debounce(now, latency) == false)
+				{
+					continue;
+				}
+				++debounceReleased;
+				debounceSumLatency += latency;
+				if (latency > debounceMaxLatency)
+				{
+					debounceMaxLatency = latency;
+				}
+				logger->Debug(Languages::TextFeedbackReleaseLatency, feedback->GetName(), latency.count());
 			}
 		}
-		Utils::Utils::SleepForMilliseconds(250);
+		expired.clear();
+		lock.lock();
 	}
+	logger->Info(Languages::TextDebounceStatistics,
+		debounceReleased,
+		debounceReleased == 0 ? 0 : debounceSumLatency.count() / debounceReleased,
+		debounceMaxLatency.count());
 	logger->Info(Languages::TextDebounceThreadTerminated);
 }
 
 template<class ID, class T>
-T* Manager::CreateAndAddObject(std::map<ID,T*>& objects, std::mutex& mutex)
+T* Manager::CreateAndAddObject(Utils::ObjectMap<ID,T*>& objects, std::mutex& mutex)
 {
 	std::lock_guard<std::mutex> Guard(mutex);
-	ID newObjectID = 0;
-	for (auto object : objects)
-	{
-		if (object.first > newObjectID)
-		{
-			newObjectID = object.first;
-		}
-	}
-	++newObjectID;
+	const ID maxObjectID = objects.MaxID();
+	const ID newObjectID = (maxObjectID > 0 ? maxObjectID : 0) + 1;
 	T* newObject = new T(this, newObjectID);
 	if (newObject == nullptr)
 	{
@@ -3369,10 +4108,73 @@ void Manager::ProgramWrite(const ControlID controlID, const ProgramMode mode, co
 
 void Manager::ProgramValue(const CvNumber cv, const CvValue value)
 {
-	std::lock_guard<std::mutex> guard(controlMutex);
-	for (auto control : controls)
+	DispatchToControls(ControlDispatcher::KeyNone,
+		[=] (ControlInterface* control)
+		{
+			control->ProgramValue(cv, value);
+		});
+}
+
+void Manager::WaitUntilAccessoryPulsesDone(const std::vector<ObjectIdentifier>& objects) const
+{
+	for (const ObjectIdentifier& object : objects)
 	{
-		control.second->ProgramValue(cv, value);;
+		const ObjectID objectID = object.GetObjectID();
+		const DataModel::AccessoryBase* accessory = nullptr;
+		ControlDispatcher::Command command;
+		Address nrOfAddresses = 1;
+		switch (object.GetObjectType())
+		{
+			case ObjectTypeAccessory:
+				accessory = GetAccessory(objectID);
+				command = ControlDispatcher::CommandAccessoryState;
+				break;
+
+			case ObjectTypeSwitch:
+			{
+				const Switch* mySwitch = GetSwitch(objectID);
+				if (mySwitch != nullptr && mySwitch->GetType() == DataModel::SwitchTypeThreeWay)
+				{
+					nrOfAddresses = 2;
+				}
+				accessory = mySwitch;
+				command = ControlDispatcher::CommandSwitchState;
+				break;
+			}
+
+			case ObjectTypeSignal:
+				accessory = GetSignal(objectID);
+				command = ControlDispatcher::CommandSignalState;
+				break;
+
+			default:
+				continue;
+		}
+		if (accessory == nullptr)
+		{
+			continue;
+		}
+
+		// only the control of the accessory is waited for, traffic of other objects and controls does not matter
+		ControlDispatcher* dispatcher;
+		ControlInterface* control;
+		{
+			std::lock_guard<std::mutex> guard(controlMutex);
+			const ControlID controlID = accessory->GetControlID();
+			if (dispatchers.count(controlID) != 1 || controls.count(controlID) != 1)
+			{
+				continue;
+			}
+			dispatcher = dispatchers.at(controlID);
+			control = controls.at(controlID);
+			++controlWaiters;
+		}
+		dispatcher->WaitUntilDispatched(ControlDispatcher::GetKey(command, ControlTypeInternal, objectID));
+		for (Address offset = 0; offset < nrOfAddresses; ++offset)
+		{
+			control->WaitUntilAccessoryPulseDone(accessory->GetProtocol(), accessory->GetAddress() + offset);
+		}
+		ControlWaitDone();
 	}
 }
 
@@ -3426,43 +4228,39 @@ bool Manager::ObjectIsPartOfRoute(const ObjectIdentifier& identifier,
 	const Object* object,
 	string& result)
 {
-	std::lock_guard<std::mutex> Guard(routeMutex);
-	for (auto route : routes)
+	const Route* route = GetRoute(routeUsage.GetFirstRoute(identifier, RouteUsageIndex::UsageRelation));
+	if (route == nullptr)
 	{
-		if (!route.second->ObjectIsPartOfRoute(identifier))
-		{
-			continue;
-		}
+		return false;
+	}
 
-		Languages::TextSelector selector;
-		switch (identifier.GetObjectType())
-		{
-			case ObjectTypeTrack:
-				selector = Languages::TextTrackIsUsedByRoute;
-				break;
+	Languages::TextSelector selector;
+	switch (identifier.GetObjectType())
+	{
+		case ObjectTypeTrack:
+			selector = Languages::TextTrackIsUsedByRoute;
+			break;
 
-			case ObjectTypeAccessory:
-				selector = Languages::TextAccessoryIsUsedByRoute;
-				break;
+		case ObjectTypeAccessory:
+			selector = Languages::TextAccessoryIsUsedByRoute;
+			break;
 
-			case ObjectTypeSwitch:
-				selector = Languages::TextSwitchIsUsedByRoute;
-				break;
+		case ObjectTypeSwitch:
+			selector = Languages::TextSwitchIsUsedByRoute;
+			break;
 
-			case ObjectTypeRoute:
-				selector = Languages::TextRouteIsUsedByRoute;
-				break;
+		case ObjectTypeRoute:
+			selector = Languages::TextRouteIsUsedByRoute;
+			break;
 
-			case ObjectTypeSignal:
-				selector = Languages::TextSignalIsUsedByRoute;
-				break;
+		case ObjectTypeSignal:
+			selector = Languages::TextSignalIsUsedByRoute;
+			break;
 
-			default:
-				selector = Languages::TextObjectIsUsedByRoute;
-				break;
-		}
-		result = Logger::Logger::Format(Languages::GetText(selector), object->GetName(), route.second->GetName());
-		return true;
+		default:
+			selector = Languages::TextObjectIsUsedByRoute;
+			break;
 	}
-	return false;
+	result = Logger::Logger::Format(Languages::GetText(selector), object->GetName(), route->GetName());
+	return true;
 }
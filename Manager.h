@@ -20,19 +20,34 @@ along with RailControl; see the file LICENCE. If not see
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <iomanip>
+#include <limits>
+#include <unordered_map>
 #include <vector>
 
+#include "AutoModeScheduler.h"
 #include "Config.h"
+#include "ControlDispatcher.h"
 #include "ControlInterface.h"
 #include "DataModel/DataModel.h"
 #include "Hardware/HardwareParams.h"
+#include "LayoutGrid.h"
 #include "Logger/Logger.h"
+#include "RouteConflictMatrix.h"
+#include "RoutePlanner.h"
+#include "RouteUsageIndex.h"
+#include "SpeedCalibration.h"
+#include "SpeedRamp.h"
 #include "Storage/StorageHandler.h"
+#include "Utils/ObjectMap.h"
+#include "Utils/TimerWheel.h"
 
 class Manager
 {
@@ -74,6 +89,7 @@ class Manager
 		const std::map<ControlID,std::string> AccessoryControlListNames() const;
 		const std::map<ControlID,std::string> FeedbackControlListNames() const;
 		const std::map<ControlID,std::string> ProgramControlListNames() const;
+		bool GetControlDispatcherStatistics(const ControlID controlID, ControlDispatcher::Statistics& statistics) const;
 
 		inline const std::map<std::string,Protocol> LocoProtocolsOfControl(const ControlID controlID) const
 		{
@@ -92,8 +108,10 @@ class Manager
 		DataModel::Loco* GetLoco(const LocoID locoID) const;
 		const std::string& GetLocoName(const LocoID locoID) const;
 
-		inline const std::map<LocoID,DataModel::Loco*>& locoList() const
+		// returns a copy, an object added by another thread would invalidate the iterators of the caller
+		inline Utils::ObjectMap<LocoID,DataModel::Loco*> locoList() const
 		{
+			std::lock_guard<std::mutex> guard(locoMutex);
 			return locos;
 		}
 
@@ -112,6 +130,11 @@ class Manager
 			const Speed travelSpeed,
 			const Speed reducedSpeed,
 			const Speed creepingSpeed,
+			const unsigned int accelerationTime,
+			const unsigned int decelerationTime,
+			const FeedbackID calibrationFeedbackStart,
+			const FeedbackID calibrationFeedbackEnd,
+			const Length calibrationDistance,
 			const std::vector<DataModel::LocoFunctionEntry>& locoFunctions,
 			const std::vector<DataModel::Relation*>& slaves,
 			std::string& result
@@ -125,6 +148,29 @@ class Manager
 		bool LocoSpeed(const ControlType controlType, const LocoID locoID, const Speed speed, const bool withSlaves = true);
 		bool LocoSpeed(const ControlType controlType, DataModel::Loco* loco, const Speed speed, const bool withSlaves = true);
 		Speed LocoSpeed(const LocoID locoID) const;
+		// stops the loco without deceleration ramp
+		void LocoStopImmediately(const ControlType controlType, DataModel::Loco* loco, const bool withSlaves = true);
+		// called by the speed ramp with all speed steps of one tick
+		void LocoSpeedRampStep(const std::vector<SpeedRamp::Step>& steps);
+
+		bool LocoCalibrationStart(const LocoID locoID, std::string& result);
+		inline void LocoCalibrationStop()
+		{
+			speedCalibration.Stop();
+		}
+
+		inline bool LocoCalibrationRunning() const
+		{
+			return speedCalibration.IsRunning();
+		}
+
+		inline void LocoCalibrationFeedbackOccupied(const FeedbackID feedbackID)
+		{
+			speedCalibration.FeedbackOccupied(feedbackID);
+		}
+
+		// called by the speed calibration when all speed steps are measured
+		void LocoCalibrated(DataModel::Loco* loco, const DataModel::Loco::SpeedTable& table);
 		void LocoOrientation(const ControlType controlType, const ControlID controlID, const Protocol protocol, const Address address, const Orientation orientation);
 		void LocoOrientation(const ControlType controlType, const LocoID locoID, const Orientation orientation);
 		void LocoOrientation(const ControlType controlType, DataModel::Loco* loco, const Orientation orientation);
@@ -148,8 +194,9 @@ class Manager
 		DataModel::Accessory* GetAccessory(const AccessoryID accessoryID) const;
 		const std::string& GetAccessoryName(const AccessoryID accessoryID) const;
 
-		inline const std::map<AccessoryID,DataModel::Accessory*>& AccessoryList() const
+		inline Utils::ObjectMap<AccessoryID,DataModel::Accessory*> AccessoryList() const
 		{
+			std::lock_guard<std::mutex> guard(accessoryMutex);
 			return accessories;
 		}
 
@@ -175,12 +222,14 @@ class Manager
 		void FeedbackState(const ControlID controlID, const FeedbackPin pin, const DataModel::Feedback::FeedbackState state);
 		void FeedbackState(const FeedbackID feedbackID, const DataModel::Feedback::FeedbackState state);
 		void FeedbackPublishState(const DataModel::Feedback* feedback);
+		void FeedbackDebounceStart(const FeedbackID feedbackID, const std::chrono::steady_clock::time_point deadline);
 		DataModel::Feedback* GetFeedback(const FeedbackID feedbackID) const;
 		DataModel::Feedback* GetFeedbackUnlocked(const FeedbackID feedbackID) const;
 		const std::string& GetFeedbackName(const FeedbackID feedbackID) const;
 
-		inline const std::map<FeedbackID,DataModel::Feedback*>& FeedbackList() const
+		inline Utils::ObjectMap<FeedbackID,DataModel::Feedback*> FeedbackList() const
 		{
+			std::lock_guard<std::mutex> guard(feedbackMutex);
 			return feedbacks;
 		}
 
@@ -200,8 +249,9 @@ class Manager
 		DataModel::Track* GetTrack(const TrackID trackID) const;
 		const std::string& GetTrackName(const TrackID trackID) const;
 
-		inline const std::map<TrackID,DataModel::Track*>& TrackList() const
+		inline Utils::ObjectMap<TrackID,DataModel::Track*> TrackList() const
 		{
+			std::lock_guard<std::mutex> guard(trackMutex);
 			return tracks;
 		}
 
@@ -233,8 +283,9 @@ class Manager
 		DataModel::Switch* GetSwitch(const SwitchID switchID) const;
 		const std::string& GetSwitchName(const SwitchID switchID) const;
 
-		inline const std::map<SwitchID,DataModel::Switch*>& SwitchList() const
+		inline Utils::ObjectMap<SwitchID,DataModel::Switch*> SwitchList() const
 		{
+			std::lock_guard<std::mutex> guard(switchMutex);
 			return switches;
 		}
 
@@ -264,8 +315,9 @@ class Manager
 		DataModel::Route* GetRoute(const RouteID routeID) const;
 		const std::string& GetRouteName(const RouteID routeID) const;
 
-		inline const std::map<RouteID,DataModel::Route*>& RouteList() const
+		inline Utils::ObjectMap<RouteID,DataModel::Route*> RouteList() const
 		{
+			std::lock_guard<std::mutex> guard(routeMutex);
 			return routes;
 		}
 
@@ -299,11 +351,23 @@ class Manager
 			std::string& result);
 
 		DataModel::Route* GetFirstRouteToTrackBase(const DataModel::ObjectIdentifier& identifier) const;
+		// routes that do not use an object of a route locked by another loco
+		void RouteGetConflictFree(const LocoID locoID, RouteConflictMatrix::Bitset& freeRoutes) const;
+		inline bool RoutesConflict(const RouteID routeID1, const RouteID routeID2) const
+		{
+			return routeConflicts.Conflict(routeID1, routeID2);
+		}
 
 		// layer
 		DataModel::Layer* GetLayer(const LayerID layerID) const;
 		const std::map<std::string,LayerID> LayerListByName() const;
 		const std::map<std::string,LayerID> LayerListByNameWithFeedback() const;
+
+		// all visible layout items of a layer ordered by type and ID
+		inline void LayoutItemsOnLayer(const LayerID layer, std::vector<LayoutGrid::Item>& items) const
+		{
+			layoutGrid.GetItemsOnLayer(static_cast<DataModel::LayoutItem::LayoutPosition>(layer), items);
+		}
 		bool LayerSave(const LayerID layerID, const std::string&name, std::string& result);
 
 		bool LayerDelete(const LayerID layerID,
@@ -315,8 +379,9 @@ class Manager
 		DataModel::Signal* GetSignal(const SignalID signalID) const;
 		const std::string& GetSignalName(const SignalID signalID) const;
 
-		inline const std::map<SignalID,DataModel::Signal*>& SignalList() const
+		inline Utils::ObjectMap<SignalID,DataModel::Signal*> SignalList() const
 		{
+			std::lock_guard<std::mutex> guard(signalMutex);
 			return signals;
 		}
 
@@ -362,6 +427,47 @@ class Manager
 		// automode
 		bool LocoIntoTrackBase(Logger::Logger* logger, const LocoID locoID, const DataModel::ObjectIdentifier& trackIdentifier);
 		bool LocoRelease(const LocoID locoID);
+		// wakes up all locos in automode, e.g. because a route or a track has been released
+		void LocoWakeUpAutoModeAll() const;
+		void LocoAutoModeWakeUp(DataModel::Loco* loco) const;
+		void LocoAutoModeRemove(DataModel::Loco* loco) const;
+		// wait-for graph of the automode with one list of locos per blocked route: the loco can leave
+		// through any of the routes, a route is free when all of its locos have moved away.
+		// An empty list removes the loco from the graph.
+		void LocoWaitsFor(const LocoID locoID, const std::vector<std::vector<LocoID>>& blockingLocos);
+		// checks if a loco standing on the track in this orientation could leave it again
+		bool LocoCanLeaveTrackBase(Logger::Logger* logger,
+			const DataModel::Loco* loco,
+			const DataModel::TrackBase* track,
+			const Orientation orientation,
+			std::vector<LocoID>& visitedLocos,
+			const unsigned int depth) const;
+		void LocoDeadlockAvoided();
+		void GetDeadlockStatistics(uint64_t& detected, uint64_t& avoided) const;
+		static const unsigned int DeadlockLookaheadDepth = 4;
+		// plans the routes a loco has to drive from its track to a destination track
+		bool RoutePlan(const LocoID locoID,
+			const DataModel::ObjectIdentifier& to,
+			std::vector<DataModel::Route*>& path);
+		static const unsigned int RoutePlanMaxTime = 1000;
+
+		inline std::chrono::milliseconds GetAutoModeIdleRecheck() const
+		{
+			return autoModeIdleRecheck;
+		}
+
+		// 0 means that the Z21 sends every command in its own datagram
+		inline std::chrono::milliseconds GetZ21BatchWindow() const
+		{
+			return z21BatchWindow;
+		}
+
+		// minimum time between two accessory commands to a M6051
+		inline unsigned int GetM6051CommandGap() const
+		{
+			return m6051CommandGap;
+		}
+
 		bool TrackBaseRelease(const DataModel::ObjectIdentifier& objectIdentifier);
 		bool LocoReleaseOnTrackBase(const DataModel::ObjectIdentifier& objectIdentifier);
 		bool TrackBaseStartLoco(const DataModel::ObjectIdentifier& objectIdentifier);
@@ -370,6 +476,8 @@ class Manager
 		void TrackBaseSetLocoOrientation(const DataModel::ObjectIdentifier& objectIdentifier, const Orientation orientation);
 		void TrackPublishState(const DataModel::Track* track);
 		bool RouteRelease(const RouteID routeID);
+		// reserves and locks a route for a loco completely or not at all
+		bool RouteReserveAndLock(Logger::Logger* logger, DataModel::Route* route, const LocoID locoID);
 		bool LocoDestinationReached(const DataModel::Loco* loco, const DataModel::Route* route, const DataModel::TrackBase* track);
 		bool LocoStart(const LocoID locoID);
 		bool LocoStop(const LocoID locoID);
@@ -393,6 +501,11 @@ class Manager
 			return stopOnFeedbackInFreeTrack;
 		}
 
+		inline bool GetExecuteRoutesInBatches() const
+		{
+			return executeRoutesInBatches;
+		}
+
 		inline DataModel::SelectRouteApproach GetSelectRouteApproach() const
 		{
 			return selectRouteApproach;
@@ -407,6 +520,7 @@ class Manager
 			const DataModel::AccessoryPulseDuration duration,
 			const bool autoAddFeedback,
 			const bool stopOnFeedbackInFreeTrack,
+			const bool executeRoutesInBatches,
 			const DataModel::SelectRouteApproach selectRouteApproach,
 			const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve,
 			const Logger::Logger::Level logLevel
@@ -426,12 +540,22 @@ class Manager
 		}
 
 		bool CanHandle(const Hardware::Capabilities capability) const;
+
+		// waits until the queued commands of these accessories, switches and signals have been sent and their pulses are over
+		void WaitUntilAccessoryPulsesDone(const std::vector<DataModel::ObjectIdentifier>& objects) const;
 		Hardware::Capabilities GetCapabilities(const ControlID controlID) const;
 
 	private:
 		bool ControlIsOfHardwareType(const ControlID controlID, const HardwareType hardwareType);
 
 		ControlInterface* GetControl(const ControlID controlID) const;
+
+		// queues the task on the dispatcher of every control, the caller does not wait for the controls
+		void DispatchToControls(const ControlDispatcher::Key key, const ControlDispatcher::Task& task) const;
+		// must be called before deleting an object that has been handed over to queued tasks
+		void WaitUntilDispatchedToControls() const;
+		void ControlWaitDone() const;
+
 		DataModel::Loco* GetLoco(const ControlID controlID, const Protocol protocol, const Address address) const;
 		DataModel::Accessory* GetAccessory(const ControlID controlID, const Protocol protocol, const Address address) const;
 		DataModel::Switch* GetSwitch(const ControlID controlID, const Protocol protocol, const Address address) const;
@@ -464,13 +588,6 @@ class Manager
 			const DataModel::LayoutItem::LayoutRotation rotation,
 			std::string& result) const;
 
-		template<class Type>
-		bool CheckLayoutPositionFree(const DataModel::LayoutItem::LayoutPosition posX,
-			const DataModel::LayoutItem::LayoutPosition posY,
-			const DataModel::LayoutItem::LayoutPosition posZ,
-			std::string& result,
-			const std::map<ObjectID, Type*>& layoutVector, std::mutex& mutex) const;
-
 		bool CheckAccessoryPosition(const DataModel::Accessory* accessory,
 			const DataModel::LayoutItem::LayoutPosition posX,
 			const DataModel::LayoutItem::LayoutPosition posY,
@@ -483,6 +600,13 @@ class Manager
 			const DataModel::LayoutItem::LayoutPosition posZ,
 			std::string& result) const;
 
+		void RouteConflictsUpdate(const DataModel::Route* route);
+
+		static inline DataModel::Loco::NrOfTracksToReserve CheckNrOfTracksToReserve(const int nrOfTracksToReserve)
+		{
+			return static_cast<DataModel::Loco::NrOfTracksToReserve>(std::min(std::max(nrOfTracksToReserve, static_cast<int>(DataModel::Loco::ReserveOne)), static_cast<int>(DataModel::Loco::ReserveMax)));
+		}
+
 		bool CheckRoutePosition(const DataModel::Route* route,
 			const DataModel::LayoutItem::LayoutPosition posX,
 			const DataModel::LayoutItem::LayoutPosition posY,
@@ -526,12 +650,17 @@ class Manager
 		const std::map<std::string,Protocol> ProtocolsOfControl(const AddressType type, const ControlID) const;
 
 		bool LocoReleaseInternal(DataModel::Loco* loco);
+		void LocoSlaves(const DataModel::Loco* loco, std::vector<DataModel::Loco*>& slaves) const;
+		void LocoSpeedImmediately(const ControlType controlType,
+			DataModel::Loco* loco,
+			const std::vector<DataModel::Loco*>& slaves,
+			const Speed speed);
 
 		bool LayerHasElements(const DataModel::Layer* layer,
 			std::string& result);
 
 		template<class Key, class Value>
-		void DeleteAllMapEntries(std::map<Key,Value*>& m, std::mutex& x)
+		void DeleteAllMapEntries(Utils::ObjectMap<Key,Value*>& m, std::mutex& x)
 		{
 			std::lock_guard<std::mutex> Guard(x);
 			while (m.size())
@@ -550,14 +679,93 @@ class Manager
 
 		const std::vector<FeedbackID> CleanupAndCheckFeedbacksForTrack(const DataModel::ObjectIdentifier& identifier, const std::vector<FeedbackID>& newFeedbacks);
 		void DebounceWorker();
+		Utils::TimerWheel::Tick GetDebounceTick(const std::chrono::steady_clock::time_point time, const bool roundUp) const;
 
 		template<class ID, class T>
-		T* CreateAndAddObject(std::map<ID,T*>& objects, std::mutex& mutex);
+		T* CreateAndAddObject(Utils::ObjectMap<ID,T*>& objects, std::mutex& mutex);
 
-		Hardware::HardwareParams* CreateAndAddControl();
+		// the hardware address index maps controlID/protocol/address to the object with the lowest ID using it
+		typedef uint32_t HardwareAddressKey;
 
+		static inline HardwareAddressKey GetHardwareAddressKey(const ControlID controlID, const Protocol protocol, const Address address)
+		{
+			return (static_cast<HardwareAddressKey>(controlID) << 24)
+				| (static_cast<HardwareAddressKey>(protocol) << 16)
+				| static_cast<HardwareAddressKey>(address);
+		}
+
+		static inline HardwareAddressKey GetHardwareAddressKey(const DataModel::HardwareHandle* object)
+		{
+			return GetHardwareAddressKey(object->GetControlID(), object->GetProtocol(), object->GetAddress());
+		}
+
+		template<class T>
+		T* HardwareAddressIndexGet(const std::unordered_map<HardwareAddressKey,T*>& index, const HardwareAddressKey key) const
+		{
+			auto entry = index.find(key);
+			if (entry == index.end())
+			{
+				return nullptr;
+			}
+			return entry->second;
+		}
+
+		template<class T>
+		void HardwareAddressIndexAdd(std::unordered_map<HardwareAddressKey,T*>& index, const HardwareAddressKey key, T* object)
+		{
+			T* existing = HardwareAddressIndexGet(index, key);
+			if (existing != nullptr && existing->GetID() < object->GetID())
+			{
+				return;
+			}
+			index[key] = object;
+		}
+
+		// mutex of objects must be locked when calling this function
 		template<class ID, class T>
-		bool CheckObjectName(std::map<ID,T*>& objects, const std::string& name)
+		void HardwareAddressIndexRemove(std::unordered_map<HardwareAddressKey,T*>& index, const Utils::ObjectMap<ID,T*>& objects, const HardwareAddressKey key, const T* object)
+		{
+			if (HardwareAddressIndexGet(index, key) != object)
+			{
+				return;
+			}
+			index.erase(key);
+			// another object may use the same address, it takes over the index entry
+			for (auto other : objects)
+			{
+				if (other.second != object && GetHardwareAddressKey(other.second) == key)
+				{
+					HardwareAddressIndexAdd(index, key, other.second);
+				}
+			}
+		}
+
+		// mutex of objects must be locked when calling this function
+		template<class ID, class T>
+		void HardwareAddressIndexUpdate(std::unordered_map<HardwareAddressKey,T*>& index, const Utils::ObjectMap<ID,T*>& objects, const HardwareAddressKey oldKey, T* object)
+		{
+			HardwareAddressIndexRemove(index, objects, oldKey, object);
+			HardwareAddressIndexAdd(index, GetHardwareAddressKey(object), object);
+		}
+
+		// feedbackMutex must be locked when calling this function
+		void FeedbackPinTableBuild(const ControlID controlID);
+
+		template<class ID, class T>
+		void HardwareAddressIndexBuild(std::unordered_map<HardwareAddressKey,T*>& index, const Utils::ObjectMap<ID,T*>& objects)
+		{
+			index.clear();
+			for (auto object : objects)
+			{
+				HardwareAddressIndexAdd(index, GetHardwareAddressKey(object.second), object.second);
+			}
+		}
+
+		Hardware::HardwareParams* CreateAndAddControl();
+
+		// works on the object registries as well as on the std::map of the controls
+		template<class Objects>
+		bool CheckObjectName(Objects& objects, const std::string& name)
 		{
 			for (auto object : objects)
 			{
@@ -583,13 +791,13 @@ class Manager
 			&& CheckIfNumber(s.at(sSize-3));
 		}
 
-		template<class ID, class T>
-		std::string CheckObjectName(std::map<ID,T*>& objects, std::mutex& mutex, const ID objectID, const std::string& name)
+		template<class Objects, class ID>
+		std::string CheckObjectName(Objects& objects, std::mutex& mutex, const ID objectID, const std::string& name)
 		{
 			std::lock_guard<std::mutex> Guard(mutex);
 			if (objects.count(objectID) == 1)
 			{
-				const T* o = objects.at(objectID);
+				const auto* o = objects.at(objectID);
 				const std::string& oldName = o->GetName();
 				if (oldName.compare(name) == 0)
 				{
@@ -639,7 +847,13 @@ class Manager
 
 		// controls (Webserver & hardwareHandler. So each hardware is also added here).
 		std::map<ControlID,ControlInterface*> controls;
+		// one dispatcher per control, guarded by controlMutex
+		std::map<ControlID,ControlDispatcher*> dispatchers;
 		mutable std::mutex controlMutex;
+		// number of threads waiting on a control or dispatcher without holding controlMutex,
+		// a deleted control is only freed when it drops to 0
+		mutable unsigned int controlWaiters;
+		mutable std::condition_variable controlWaitersCondition;
 
 		// hardware (virt, CS2, ...)
 		std::map<ControlID,Hardware::HardwareParams*> hardwareParams;
@@ -649,39 +863,51 @@ class Manager
 		mutable std::mutex hardwareLibrariesMutex;
 
 		// loco
-		std::map<LocoID,DataModel::Loco*> locos;
+		Utils::ObjectMap<LocoID,DataModel::Loco*> locos;
+		std::unordered_map<HardwareAddressKey,DataModel::Loco*> locosByAddress;
 		mutable std::mutex locoMutex;
 
 		// accessory
-		std::map<AccessoryID,DataModel::Accessory*> accessories;
+		Utils::ObjectMap<AccessoryID,DataModel::Accessory*> accessories;
+		std::unordered_map<HardwareAddressKey,DataModel::Accessory*> accessoriesByAddress;
 		mutable std::mutex accessoryMutex;
 
 		// feedback
-		std::map<FeedbackID,DataModel::Feedback*> feedbacks;
+		Utils::ObjectMap<FeedbackID,DataModel::Feedback*> feedbacks;
+		// per control a table indexed by pin, pins beyond MaxFeedbackPinTable are looked up in feedbacks
+		static const FeedbackPin MaxFeedbackPinTable = 0xFFFF;
+		std::vector<DataModel::Feedback*> feedbacksByPin[std::numeric_limits<ControlID>::max() + 1];
 		mutable std::mutex feedbackMutex;
 
 		// track
-		std::map<TrackID,DataModel::Track*> tracks;
+		Utils::ObjectMap<TrackID,DataModel::Track*> tracks;
 		mutable std::mutex trackMutex;
 
 		// switch
-		std::map<SwitchID,DataModel::Switch*> switches;
+		Utils::ObjectMap<SwitchID,DataModel::Switch*> switches;
+		std::unordered_map<HardwareAddressKey,DataModel::Switch*> switchesByAddress;
 		mutable std::mutex switchMutex;
 
 		// route
-		std::map<RouteID,DataModel::Route*> routes;
+		Utils::ObjectMap<RouteID,DataModel::Route*> routes;
 		mutable std::mutex routeMutex;
+		RoutePlanner routePlanner;
+		RouteConflictMatrix routeConflicts;
+		RouteUsageIndex routeUsage;
 
 		// layer
-		std::map<LayerID,DataModel::Layer*> layers;
+		Utils::ObjectMap<LayerID,DataModel::Layer*> layers;
 		mutable std::mutex layerMutex;
+		// positions of all layout items on all layers
+		LayoutGrid layoutGrid;
 
 		// signal
-		std::map<SignalID,DataModel::Signal*> signals;
+		Utils::ObjectMap<SignalID,DataModel::Signal*> signals;
+		std::unordered_map<HardwareAddressKey,DataModel::Signal*> signalsByAddress;
 		mutable std::mutex signalMutex;
 
 		// cluster
-		std::map<SignalID,DataModel::Cluster*> clusters;
+		Utils::ObjectMap<SignalID,DataModel::Cluster*> clusters;
 		mutable std::mutex clusterMutex;
 
 		// storage
@@ -690,12 +916,47 @@ class Manager
 		DataModel::AccessoryPulseDuration defaultAccessoryDuration;
 		bool autoAddFeedback;
 		bool stopOnFeedbackInFreeTrack;
+		bool executeRoutesInBatches;
+		std::chrono::milliseconds autoModeIdleRecheck;
+		static const int MinAutoModeIdleRecheck = 10;
+		std::chrono::milliseconds z21BatchWindow;
+		static const int MaxZ21BatchWindow = 100;
+		unsigned int m6051CommandGap;
+		static const int MaxM6051CommandGap = 1000;
 		DataModel::SelectRouteApproach selectRouteApproach;
 		DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve;
+		AutoModeScheduler* autoModeScheduler;
+		SpeedRamp* speedRamp;
+		SpeedCalibration speedCalibration;
 
 		volatile bool run;
 		volatile bool debounceRun;
 		std::thread debounceThread;
+		// only falling feedbacks are in the wheel, one tick is debounceResolution long
+		Utils::TimerWheel debounceWheel;
+		std::mutex debounceMutex;
+		std::condition_variable debounceCondition;
+		std::chrono::milliseconds debounceResolution;
+		std::chrono::steady_clock::time_point debounceEpoch;
+		static const int MinDebounceResolution = 10;
+		// release latency statistics, only used by the debounce thread
+		uint64_t debounceReleased;
+		std::chrono::microseconds debounceSumLatency;
+		std::chrono::microseconds debounceMaxLatency;
+
+		// all reservation transactions are serialized by this mutex
+		std::mutex reservationMutex;
+		uint64_t reservationsCommitted;
+		uint64_t reservationsRejected;
+		uint64_t reservationsRolledBack;
+		uint64_t reservationsContended;
+
+		// locos in automode that can not reserve a route and the locos they are waiting for
+		std::map<LocoID,std::vector<std::vector<LocoID>>> waitFor;
+		std::vector<LocoID> deadlockedLocos;
+		mutable std::mutex waitForMutex;
+		uint64_t deadlocksDetected;
+		uint64_t deadlocksAvoided;
 
 		volatile bool initLocosDone;
 
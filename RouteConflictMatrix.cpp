@@ -0,0 +1,143 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "RouteConflictMatrix.h"
+
+using DataModel::ObjectIdentifier;
+using std::vector;
+
+RouteConflictMatrix::RouteConflictMatrix()
+:	words(0)
+{
+}
+
+void RouteConflictMatrix::Update(const RouteID routeID, const vector<ObjectIdentifier>& objects)
+{
+	std::lock_guard<std::mutex> guard(matrixMutex);
+	Resize(routeID);
+	RemoveUnlocked(routeID);
+
+	vector<ObjectKey>& keys = objectsByRoute[routeID];
+	for (auto& object : objects)
+	{
+		keys.push_back(GetObjectKey(object));
+	}
+	std::sort(keys.begin(), keys.end());
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+	Bitset& row = conflicts[routeID];
+	for (auto key : keys)
+	{
+		Bitset& routes = routesByObject[key];
+		routes.resize(words, 0);
+		Set(routes, routeID);
+		for (size_t word = 0; word < words; ++word)
+		{
+			row[word] |= routes[word];
+		}
+	}
+
+	// the matrix is symmetric
+	for (size_t otherRouteID = 0; otherRouteID < conflicts.size(); ++otherRouteID)
+	{
+		if (IsSet(row, static_cast<RouteID>(otherRouteID)))
+		{
+			Set(conflicts[otherRouteID], routeID);
+		}
+	}
+}
+
+void RouteConflictMatrix::Remove(const RouteID routeID)
+{
+	std::lock_guard<std::mutex> guard(matrixMutex);
+	if (routeID >= conflicts.size())
+	{
+		return;
+	}
+	RemoveUnlocked(routeID);
+}
+
+bool RouteConflictMatrix::Conflict(const RouteID routeID1, const RouteID routeID2) const
+{
+	std::lock_guard<std::mutex> guard(matrixMutex);
+	if (routeID1 >= conflicts.size())
+	{
+		return false;
+	}
+	return IsSet(conflicts[routeID1], routeID2);
+}
+
+void RouteConflictMatrix::GetFreeRoutes(const vector<RouteID>& busyRoutes, Bitset& freeRoutes) const
+{
+	std::lock_guard<std::mutex> guard(matrixMutex);
+	freeRoutes.assign(words, ~static_cast<uint64_t>(0));
+	for (auto routeID : busyRoutes)
+	{
+		if (routeID >= conflicts.size())
+		{
+			continue;
+		}
+		const Bitset& row = conflicts[routeID];
+		for (size_t word = 0; word < words; ++word)
+		{
+			freeRoutes[word] &= ~row[word];
+		}
+	}
+}
+
+void RouteConflictMatrix::Resize(const RouteID routeID)
+{
+	if (routeID < conflicts.size())
+	{
+		return;
+	}
+	conflicts.resize(routeID + 1);
+	objectsByRoute.resize(routeID + 1);
+	words = (conflicts.size() + BitsPerWord - 1) / BitsPerWord;
+	for (auto& row : conflicts)
+	{
+		row.resize(words, 0);
+	}
+	for (auto& routes : routesByObject)
+	{
+		routes.second.resize(words, 0);
+	}
+}
+
+void RouteConflictMatrix::RemoveUnlocked(const RouteID routeID)
+{
+	for (auto key : objectsByRoute[routeID])
+	{
+		Clear(routesByObject[key], routeID);
+	}
+	objectsByRoute[routeID].clear();
+
+	Bitset& row = conflicts[routeID];
+	for (size_t otherRouteID = 0; otherRouteID < conflicts.size(); ++otherRouteID)
+	{
+		if (IsSet(row, static_cast<RouteID>(otherRouteID)))
+		{
+			Clear(conflicts[otherRouteID], routeID);
+		}
+	}
+	row.assign(words, 0);
+}
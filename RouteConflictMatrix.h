@@ -0,0 +1,86 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "DataTypes.h"
+#include "DataModel/ObjectIdentifier.h"
+
+// Knows for every pair of routes if they use a common object (track, signal, switch,
+// accessory or route) and can therefore not be locked at the same time. The conflicts of
+// a route are stored as bitset indexed by route id, so the routes that are still free
+// beside a set of busy routes are found with word wise bit operations.
+class RouteConflictMatrix
+{
+	public:
+		typedef std::vector<uint64_t> Bitset;
+
+		static inline bool IsSet(const Bitset& bitset, const RouteID routeID)
+		{
+			const size_t word = routeID / BitsPerWord;
+			return word < bitset.size() && ((bitset[word] >> (routeID % BitsPerWord)) & 1);
+		}
+
+		RouteConflictMatrix();
+
+		// sets the objects a route is using and updates the conflicts of all routes
+		void Update(const RouteID routeID, const std::vector<DataModel::ObjectIdentifier>& objects);
+		void Remove(const RouteID routeID);
+
+		bool Conflict(const RouteID routeID1, const RouteID routeID2) const;
+
+		// returns all routes that do not conflict with any of the busy routes
+		void GetFreeRoutes(const std::vector<RouteID>& busyRoutes, Bitset& freeRoutes) const;
+
+	private:
+		typedef uint32_t ObjectKey;
+
+		static const size_t BitsPerWord = 64;
+
+		static inline ObjectKey GetObjectKey(const DataModel::ObjectIdentifier& object)
+		{
+			return (static_cast<ObjectKey>(object.GetObjectType()) << 16) | object.GetObjectID();
+		}
+
+		static inline void Set(Bitset& bitset, const RouteID routeID)
+		{
+			bitset[routeID / BitsPerWord] |= (static_cast<uint64_t>(1) << (routeID % BitsPerWord));
+		}
+
+		static inline void Clear(Bitset& bitset, const RouteID routeID)
+		{
+			bitset[routeID / BitsPerWord] &= ~(static_cast<uint64_t>(1) << (routeID % BitsPerWord));
+		}
+
+		void Resize(const RouteID routeID);
+		void RemoveUnlocked(const RouteID routeID);
+
+		mutable std::mutex matrixMutex;
+		size_t words;
+		// per object all routes that are using it
+		std::map<ObjectKey,Bitset> routesByObject;
+		std::vector<std::vector<ObjectKey>> objectsByRoute;
+		std::vector<Bitset> conflicts;
+};
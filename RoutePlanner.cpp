@@ -0,0 +1,261 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include "RoutePlanner.h"
+
+using DataModel::ObjectIdentifier;
+using DataModel::Route;
+using std::map;
+using std::vector;
+
+bool RoutePlanner::Plan(const Utils::ObjectMap<RouteID,Route*>& routes,
+	const TrackSet& turnTracks,
+	const ObjectIdentifier& from,
+	const Orientation fromOrientation,
+	const ObjectIdentifier& to,
+	const bool pushpull,
+	const Length length,
+	const bool allowLocoTurn,
+	vector<Route*>& path)
+{
+	path.clear();
+	if (from == to)
+	{
+		return true;
+	}
+
+	std::lock_guard<std::mutex> guard(plannerMutex);
+	if (graphValid == false)
+	{
+		BuildGraph(routes, turnTracks);
+	}
+
+	TreeKey key;
+	key.source = GetNodeIndex(from, fromOrientation);
+	key.length = length;
+	key.pushpull = pushpull;
+	key.allowLocoTurn = allowLocoTurn;
+	auto treeIterator = trees.find(key);
+	if (treeIterator == trees.end())
+	{
+		treeIterator = trees.insert(std::make_pair(key, Tree())).first;
+		CalculateTree(key, treeIterator->second);
+	}
+	const Tree& tree = treeIterator->second;
+
+	const NodeIndex destinationLeft = GetNodeIndex(to, OrientationLeft);
+	const NodeIndex destinationRight = GetNodeIndex(to, OrientationRight);
+	const Cost costLeft = GetCost(tree, destinationLeft);
+	const Cost costRight = GetCost(tree, destinationRight);
+	if (costLeft == CostInfinite && costRight == CostInfinite)
+	{
+		return false;
+	}
+
+	NodeIndex node = costLeft < costRight ? destinationLeft : destinationRight;
+	while (node != key.source)
+	{
+		if (tree.via[node] != nullptr)
+		{
+			path.push_back(tree.via[node]);
+		}
+		node = tree.previous[node];
+	}
+	std::reverse(path.begin(), path.end());
+	return true;
+}
+
+void RoutePlanner::TrackBaseChanged(const ObjectIdentifier& track)
+{
+	std::lock_guard<std::mutex> guard(plannerMutex);
+	graphValid = false;
+	for (auto tree = trees.begin(); tree != trees.end();)
+	{
+		// a tree that does not reach the track can not use a route starting there
+		if (IsReached(tree->second, track, OrientationLeft) || IsReached(tree->second, track, OrientationRight))
+		{
+			tree = trees.erase(tree);
+			continue;
+		}
+		++tree;
+	}
+}
+
+RoutePlanner::Cost RoutePlanner::GetRouteCost(const Route* route)
+{
+	// routes have no length, the minimal train length is used for the shortest route approach too
+	const Cost cost = CostHop + route->GetMinTrainLength();
+	switch (route->GetSpeed())
+	{
+		case Route::SpeedCreeping:
+			return cost * 4;
+
+		case Route::SpeedReduced:
+			return cost * 2;
+
+		case Route::SpeedTravel:
+		case Route::SpeedMax:
+		default:
+			return cost;
+	}
+}
+
+RoutePlanner::NodeIndex RoutePlanner::GetNodeIndex(const ObjectIdentifier& track, const Orientation orientation)
+{
+	const NodeKey nodeKey = GetNodeKey(track, orientation);
+	auto nodeIndex = nodeIndexes.find(nodeKey);
+	if (nodeIndex != nodeIndexes.end())
+	{
+		return nodeIndex->second;
+	}
+	const NodeIndex newNodeIndex = static_cast<NodeIndex>(nodes.size());
+	nodeIndexes[nodeKey] = newNodeIndex;
+	nodes.push_back(vector<Edge>());
+	return newNodeIndex;
+}
+
+bool RoutePlanner::IsReached(const Tree& tree, const ObjectIdentifier& track, const Orientation orientation) const
+{
+	auto nodeIndex = nodeIndexes.find(GetNodeKey(track, orientation));
+	if (nodeIndex == nodeIndexes.end())
+	{
+		return false;
+	}
+	return GetCost(tree, nodeIndex->second) != CostInfinite;
+}
+
+void RoutePlanner::BuildGraph(const Utils::ObjectMap<RouteID,Route*>& routes, const TrackSet& turnTracks)
+{
+	for (auto& node : nodes)
+	{
+		node.clear();
+	}
+
+	for (auto routeIterator : routes)
+	{
+		Route* route = routeIterator.second;
+		if (route->GetAutomode() == AutomodeNo)
+		{
+			continue;
+		}
+		const ObjectIdentifier& fromTrack = route->GetFromTrack();
+		const ObjectIdentifier& toTrack = route->GetToTrack();
+		if (fromTrack.IsSet() == false || toTrack.IsSet() == false)
+		{
+			continue;
+		}
+		const NodeIndex fromNode = GetNodeIndex(fromTrack, route->GetFromOrientation());
+		Edge edge;
+		edge.route = route;
+		edge.to = GetNodeIndex(toTrack, route->GetToOrientation());
+		edge.cost = GetRouteCost(route);
+		edge.pushpull = route->GetPushpull();
+		edge.minTrainLength = route->GetMinTrainLength();
+		edge.maxTrainLength = route->GetMaxTrainLength();
+		nodes[fromNode].push_back(edge);
+
+		// pushpull trains may leave the start track in the other orientation
+		if (turnTracks.count(GetTrackKey(fromTrack)) == 0)
+		{
+			continue;
+		}
+		const Orientation otherOrientation = static_cast<Orientation>(!route->GetFromOrientation());
+		const NodeIndex otherNode = GetNodeIndex(fromTrack, otherOrientation);
+		bool turnExists = false;
+		for (auto& otherEdge : nodes[otherNode])
+		{
+			if (otherEdge.route == nullptr && otherEdge.to == fromNode)
+			{
+				turnExists = true;
+				break;
+			}
+		}
+		if (turnExists)
+		{
+			continue;
+		}
+		Edge turn;
+		turn.route = nullptr;
+		turn.to = fromNode;
+		turn.cost = CostTurn;
+		turn.pushpull = Route::PushpullTypeOnly;
+		turn.minTrainLength = 0;
+		turn.maxTrainLength = 0;
+		nodes[otherNode].push_back(turn);
+	}
+	graphValid = true;
+}
+
+void RoutePlanner::CalculateTree(const TreeKey& key, Tree& tree) const
+{
+	const size_t nrOfNodes = nodes.size();
+	tree.cost.assign(nrOfNodes, static_cast<Cost>(CostInfinite));
+	tree.previous.assign(nrOfNodes, key.source);
+	tree.via.assign(nrOfNodes, nullptr);
+
+	typedef std::pair<Cost,NodeIndex> QueueEntry;
+	std::priority_queue<QueueEntry,vector<QueueEntry>,std::greater<QueueEntry>> queue;
+	tree.cost[key.source] = 0;
+	queue.push(QueueEntry(0, key.source));
+	while (queue.empty() == false)
+	{
+		const QueueEntry entry = queue.top();
+		queue.pop();
+		const NodeIndex node = entry.second;
+		if (entry.first > tree.cost[node])
+		{
+			continue;
+		}
+		for (auto& edge : nodes[node])
+		{
+			if (edge.route == nullptr)
+			{
+				if (key.pushpull == false || key.allowLocoTurn == false)
+				{
+					continue;
+				}
+			}
+			else
+			{
+				if (edge.pushpull != key.pushpull && edge.pushpull != Route::PushpullTypeBoth)
+				{
+					continue;
+				}
+				if (key.length < edge.minTrainLength || (edge.maxTrainLength > 0 && key.length > edge.maxTrainLength))
+				{
+					continue;
+				}
+			}
+			const Cost cost = tree.cost[node] + edge.cost;
+			if (cost >= tree.cost[edge.to])
+			{
+				continue;
+			}
+			tree.cost[edge.to] = cost;
+			tree.previous[edge.to] = node;
+			tree.via[edge.to] = edge.route;
+			queue.push(QueueEntry(cost, edge.to));
+		}
+	}
+}
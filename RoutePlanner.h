@@ -0,0 +1,154 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "DataTypes.h"
+#include "DataModel/ObjectIdentifier.h"
+#include "DataModel/Route.h"
+#include "Utils/ObjectMap.h"
+
+// Plans a path over several routes from a track to a destination track. The nodes of the
+// graph are the tracks and signals in both orientations, the edges are the routes in
+// automode and the loco turns on tracks that allow it. The shortest path tree of a start
+// node is calculated once per train class and cached until a route starting on a track
+// that is reachable in the tree changes.
+// The planner does not look up any tracks or signals itself. The caller passes the tracks
+// that allow a loco turn, so it can collect them before taking routeMutex and the mutexes
+// of the tracks and signals are never taken while routeMutex is held.
+class RoutePlanner
+{
+	public:
+		typedef std::unordered_set<uint64_t> TrackSet;
+
+		RoutePlanner()
+		:	graphValid(false)
+		{
+		}
+
+		static inline uint64_t GetTrackKey(const DataModel::ObjectIdentifier& track)
+		{
+			return GetNodeKey(track, OrientationLeft);
+		}
+
+		// the routes must not be changed while planning
+		bool Plan(const Utils::ObjectMap<RouteID,DataModel::Route*>& routes,
+			const TrackSet& turnTracks,
+			const DataModel::ObjectIdentifier& from,
+			const Orientation fromOrientation,
+			const DataModel::ObjectIdentifier& to,
+			const bool pushpull,
+			const Length length,
+			const bool allowLocoTurn,
+			std::vector<DataModel::Route*>& path);
+
+		// has to be called when the track itself or a route starting on it has been changed
+		void TrackBaseChanged(const DataModel::ObjectIdentifier& track);
+
+	private:
+		typedef uint64_t NodeKey;
+		typedef uint32_t NodeIndex;
+		typedef uint32_t Cost;
+
+		static const Cost CostInfinite = std::numeric_limits<Cost>::max();
+		static const Cost CostHop = 1000;
+		static const Cost CostTurn = 500;
+
+		struct Edge
+		{
+			// nullptr if the loco turns on the track
+			DataModel::Route* route;
+			NodeIndex to;
+			Cost cost;
+			DataModel::Route::PushpullType pushpull;
+			Length minTrainLength;
+			Length maxTrainLength;
+		};
+
+		struct TreeKey
+		{
+			NodeIndex source;
+			Length length;
+			bool pushpull;
+			bool allowLocoTurn;
+
+			inline bool operator<(const TreeKey& other) const
+			{
+				if (source != other.source)
+				{
+					return source < other.source;
+				}
+				if (length != other.length)
+				{
+					return length < other.length;
+				}
+				if (pushpull != other.pushpull)
+				{
+					return pushpull < other.pushpull;
+				}
+				return allowLocoTurn < other.allowLocoTurn;
+			}
+		};
+
+		struct Tree
+		{
+			std::vector<Cost> cost;
+			std::vector<NodeIndex> previous;
+			std::vector<DataModel::Route*> via;
+		};
+
+		static inline NodeKey GetNodeKey(const DataModel::ObjectIdentifier& track, const Orientation orientation)
+		{
+			return (static_cast<NodeKey>(track.GetObjectType()) << 24)
+				| (static_cast<NodeKey>(track.GetObjectID()) << 8)
+				| static_cast<NodeKey>(orientation);
+		}
+
+		static inline Cost GetCost(const Tree& tree, const NodeIndex node)
+		{
+			// nodes added after the calculation of the tree are not reached
+			if (node >= tree.cost.size())
+			{
+				return CostInfinite;
+			}
+			return tree.cost[node];
+		}
+
+		static Cost GetRouteCost(const DataModel::Route* route);
+		NodeIndex GetNodeIndex(const DataModel::ObjectIdentifier& track, const Orientation orientation);
+		bool IsReached(const Tree& tree, const DataModel::ObjectIdentifier& track, const Orientation orientation) const;
+		void BuildGraph(const Utils::ObjectMap<RouteID,DataModel::Route*>& routes, const TrackSet& turnTracks);
+		void CalculateTree(const TreeKey& key, Tree& tree) const;
+
+		std::mutex plannerMutex;
+		bool graphValid;
+		// node indexes stay valid when the graph is rebuilt, so cached trees can survive
+		std::unordered_map<NodeKey,NodeIndex> nodeIndexes;
+		std::vector<std::vector<Edge>> nodes;
+		std::map<TreeKey,Tree> trees;
+};
@@ -0,0 +1,109 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "DataModel/Relation.h"
+#include "DataModel/Route.h"
+#include "RouteUsageIndex.h"
+
+using DataModel::ObjectIdentifier;
+using DataModel::Route;
+
+RouteUsageIndex::RouteUsageIndex()
+{
+}
+
+void RouteUsageIndex::Update(const Route* route)
+{
+	const RouteID routeID = route->GetID();
+	std::lock_guard<std::mutex> guard(indexMutex);
+	RemoveUnlocked(routeID);
+
+	for (auto relation : route->GetRelationsAtLock())
+	{
+		Add(routeID, ObjectIdentifier(relation->ObjectType2(), relation->ObjectID2()), UsageRelation);
+	}
+	for (auto relation : route->GetRelationsAtUnlock())
+	{
+		Add(routeID, ObjectIdentifier(relation->ObjectType2(), relation->ObjectID2()), UsageRelation);
+	}
+	const ObjectIdentifier& toTrack = route->GetToTrack();
+	if (toTrack.IsSet())
+	{
+		Add(routeID, toTrack, UsageDestination);
+	}
+}
+
+void RouteUsageIndex::Remove(const RouteID routeID)
+{
+	std::lock_guard<std::mutex> guard(indexMutex);
+	RemoveUnlocked(routeID);
+}
+
+RouteID RouteUsageIndex::GetFirstRoute(const ObjectIdentifier& object, const Usage usage) const
+{
+	std::lock_guard<std::mutex> guard(indexMutex);
+	auto routes = routesByObject.find(GetObjectKey(object));
+	if (routes == routesByObject.end())
+	{
+		return RouteNone;
+	}
+	for (auto route : routes->second)
+	{
+		if (route.second & usage)
+		{
+			return route.first;
+		}
+	}
+	return RouteNone;
+}
+
+void RouteUsageIndex::Add(const RouteID routeID, const ObjectIdentifier& object, const Usage usage)
+{
+	const ObjectKey key = GetObjectKey(object);
+	unsigned char& usages = routesByObject[key][routeID];
+	if (usages == 0)
+	{
+		objectsByRoute[routeID].push_back(key);
+	}
+	usages |= usage;
+}
+
+void RouteUsageIndex::RemoveUnlocked(const RouteID routeID)
+{
+	auto objects = objectsByRoute.find(routeID);
+	if (objects == objectsByRoute.end())
+	{
+		return;
+	}
+	for (auto key : objects->second)
+	{
+		auto routes = routesByObject.find(key);
+		if (routes == routesByObject.end())
+		{
+			continue;
+		}
+		routes->second.erase(routeID);
+		if (routes->second.empty())
+		{
+			routesByObject.erase(routes);
+		}
+	}
+	objectsByRoute.erase(objects);
+}
@@ -0,0 +1,72 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "DataTypes.h"
+#include "DataModel/ObjectIdentifier.h"
+
+namespace DataModel
+{
+	class Route;
+}
+
+// Knows for every object which routes are using it, either as object of a relation at lock
+// or at unlock or as destination track. Checking if an object can be deleted is a lookup
+// instead of a scan over the relations of all routes.
+class RouteUsageIndex
+{
+	public:
+		enum Usage : unsigned char
+		{
+			UsageRelation = 0x01,
+			UsageDestination = 0x02
+		};
+
+		RouteUsageIndex();
+
+		// reads the relations and the destination of the route, the route must not change meanwhile
+		void Update(const DataModel::Route* route);
+		void Remove(const RouteID routeID);
+
+		// returns the route with the lowest ID using the object in the given way or RouteNone
+		RouteID GetFirstRoute(const DataModel::ObjectIdentifier& object, const Usage usage) const;
+
+	private:
+		typedef uint32_t ObjectKey;
+
+		static inline ObjectKey GetObjectKey(const DataModel::ObjectIdentifier& object)
+		{
+			return (static_cast<ObjectKey>(object.GetObjectType()) << 16) | object.GetObjectID();
+		}
+
+		void Add(const RouteID routeID, const DataModel::ObjectIdentifier& object, const Usage usage);
+		void RemoveUnlocked(const RouteID routeID);
+
+		mutable std::mutex indexMutex;
+		// per object the routes using it with their usage flags
+		std::map<ObjectKey,std::map<RouteID,unsigned char>> routesByObject;
+		std::map<RouteID,std::vector<ObjectKey>> objectsByRoute;
+};
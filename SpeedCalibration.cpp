@@ -0,0 +1,154 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "Languages.h"
+#include "Logger/Logger.h"
+#include "Manager.h"
+#include "SpeedCalibration.h"
+
+using DataModel::Loco;
+
+SpeedCalibration::SpeedCalibration(Manager* manager)
+:	manager(manager),
+	logger(Logger::Logger::GetLogger("SpeedCalibration")),
+	loco(nullptr),
+	feedbackStart(FeedbackNone),
+	feedbackEnd(FeedbackNone),
+	distance(0),
+	phase(PhaseSettling),
+	step(0)
+{
+}
+
+bool SpeedCalibration::Start(Loco* loco)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	if (this->loco != nullptr)
+	{
+		return false;
+	}
+	this->loco = loco;
+	feedbackStart = loco->GetCalibrationFeedbackStart();
+	feedbackEnd = loco->GetCalibrationFeedbackEnd();
+	distance = loco->GetCalibrationDistance();
+	phase = PhaseSettling;
+	step = 0;
+	table.clear();
+	logger->Info(Languages::TextCalibrationStarted, loco->GetName());
+	if (manager->GetStopOnFeedbackInFreeTrack())
+	{
+		logger->Warning(Languages::TextCalibrationSuspendsFreeTrackStop, loco->GetName());
+	}
+	manager->LocoSpeed(ControlTypeInternal, loco, StepSpeed());
+	return true;
+}
+
+void SpeedCalibration::Stop()
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	if (loco == nullptr)
+	{
+		return;
+	}
+	logger->Info(Languages::TextCalibrationStopped, loco->GetName());
+	manager->LocoStopImmediately(ControlTypeInternal, loco);
+	loco = nullptr;
+}
+
+bool SpeedCalibration::IsRunning() const
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	return loco != nullptr;
+}
+
+void SpeedCalibration::Remove(const Loco* loco)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	if (this->loco != loco)
+	{
+		return;
+	}
+	this->loco = nullptr;
+}
+
+Speed SpeedCalibration::StepSpeed() const
+{
+	// a loco with a very low max speed must not get a step 0, the loco would not move
+	return std::max(static_cast<Speed>(loco->GetMaxSpeed() * (step + 1) / NrOfSteps), static_cast<Speed>(1));
+}
+
+void SpeedCalibration::FeedbackOccupied(const FeedbackID feedbackID)
+{
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::lock_guard<std::mutex> guard(mutex);
+	if (loco == nullptr)
+	{
+		return;
+	}
+
+	switch (phase)
+	{
+		case PhaseSettling:
+			if (feedbackID == feedbackEnd)
+			{
+				phase = PhaseStart;
+			}
+			return;
+
+		case PhaseStart:
+			if (feedbackID == feedbackStart)
+			{
+				started = now;
+				phase = PhaseEnd;
+			}
+			return;
+
+		case PhaseEnd:
+			if (feedbackID != feedbackEnd)
+			{
+				return;
+			}
+			break;
+	}
+
+	const uint64_t milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now - started).count();
+	if (milliseconds == 0)
+	{
+		return;
+	}
+	const Speed speed = StepSpeed();
+	const unsigned int realSpeed = static_cast<unsigned int>(static_cast<uint64_t>(distance) * 1000 / milliseconds);
+	table[speed] = realSpeed;
+	logger->Info(Languages::TextCalibratedSpeedStep, loco->GetName(), speed, realSpeed);
+
+	++step;
+	if (step < NrOfSteps)
+	{
+		phase = PhaseSettling;
+		manager->LocoSpeed(ControlTypeInternal, loco, StepSpeed());
+		return;
+	}
+
+	manager->LocoSpeed(ControlTypeInternal, loco, MinSpeed);
+	manager->LocoCalibrated(loco, table);
+	loco = nullptr;
+}
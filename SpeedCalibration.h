@@ -0,0 +1,82 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+
+#include "DataModel/Loco.h"
+#include "DataTypes.h"
+
+class Manager;
+
+namespace Logger
+{
+	class Logger;
+}
+
+// Measures the real speed of a loco at several speed steps. The loco drives round a loop
+// that contains a measured section between two feedbacks. After every speed change the loco
+// passes the end of the section once to settle its speed, then the time from the start to the
+// end feedback is measured. The result is stored as speed table of the loco. The loco is not on
+// a track, so the stop on a feedback in a free track is suspended for the whole layout while a
+// calibration is running. Therefore no loco may be in automode during a calibration.
+class SpeedCalibration
+{
+	public:
+		SpeedCalibration() = delete;
+		SpeedCalibration(Manager* manager);
+
+		// returns false if another loco is calibrated right now
+		bool Start(DataModel::Loco* loco);
+		void Stop();
+		bool IsRunning() const;
+
+		// called whenever a feedback gets occupied
+		void FeedbackOccupied(const FeedbackID feedbackID);
+
+		// stops the calibration if the loco is calibrated right now
+		void Remove(const DataModel::Loco* loco);
+
+	private:
+		enum Phase : unsigned char
+		{
+			PhaseSettling = 0,
+			PhaseStart,
+			PhaseEnd
+		};
+
+		Speed StepSpeed() const;
+
+		static const unsigned int NrOfSteps = 8;
+
+		Manager* manager;
+		Logger::Logger* logger;
+		mutable std::mutex mutex;
+		DataModel::Loco* loco;
+		FeedbackID feedbackStart;
+		FeedbackID feedbackEnd;
+		Length distance;
+		Phase phase;
+		unsigned int step;
+		std::chrono::steady_clock::time_point started;
+		DataModel::Loco::SpeedTable table;
+};
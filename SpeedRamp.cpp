@@ -0,0 +1,210 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <algorithm>
+
+#include "DataModel/Loco.h"
+#include "Manager.h"
+#include "SpeedRamp.h"
+#include "Utils/Utils.h"
+
+using DataModel::Loco;
+using std::chrono::steady_clock;
+using std::vector;
+
+SpeedRamp::SpeedRamp(Manager* manager)
+:	manager(manager),
+	run(true),
+	worker(&SpeedRamp::Worker, this)
+{
+}
+
+SpeedRamp::~SpeedRamp()
+{
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		run = false;
+		condition.notify_all();
+	}
+	worker.join();
+}
+
+bool SpeedRamp::SetTarget(const ControlType controlType,
+	Loco* loco,
+	const vector<Loco*>& slaves,
+	const Speed target)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	const Speed current = loco->GetSpeed();
+	const unsigned int rampTime = target > current ? loco->GetAccelerationTime() : loco->GetDecelerationTime();
+	if (target == current || rampTime == 0)
+	{
+		ramps.erase(loco);
+		return false;
+	}
+
+	// a running ramp is restarted from the speed reached so far
+	Ramp& ramp = ramps[loco];
+	ramp.controlType = controlType;
+	ramp.slaves = slaves;
+	ramp.start = current;
+	ramp.target = target;
+	ramp.current = current;
+	ramp.tolerance = RoundingTolerance(loco->GetProtocol());
+	ramp.startTime = steady_clock::now();
+	ramp.rampTime = rampTime;
+	condition.notify_all();
+	return true;
+}
+
+void SpeedRamp::Cancel(Loco* loco)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	ramps.erase(loco);
+}
+
+bool SpeedRamp::IsEchoOrCancel(Loco* loco, const Speed speed)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	auto rampIterator = ramps.find(loco);
+	if (rampIterator == ramps.end())
+	{
+		return false;
+	}
+
+	// the echo of an earlier step may arrive after the next step has been sent
+	const Ramp& ramp = rampIterator->second;
+	const Speed sentMin = std::min(ramp.start, ramp.current);
+	const Speed sentMax = std::max(ramp.start, ramp.current);
+	if (speed + ramp.tolerance >= sentMin && speed <= sentMax + ramp.tolerance)
+	{
+		return true;
+	}
+	ramps.erase(rampIterator);
+	return false;
+}
+
+Speed SpeedRamp::RoundingTolerance(const Protocol protocol)
+{
+	unsigned int speedSteps;
+	switch (protocol)
+	{
+		case ProtocolMM1:
+		case ProtocolMM2:
+		case ProtocolMM:
+		case ProtocolMM15:
+		case ProtocolDCC14:
+			speedSteps = 14;
+			break;
+
+		case ProtocolDCC28:
+			speedSteps = 28;
+			break;
+
+		case ProtocolSX1:
+			speedSteps = 31;
+			break;
+
+		default:
+			speedSteps = 126;
+			break;
+	}
+	return MaxSpeed / speedSteps + 1;
+}
+
+void SpeedRamp::Remove(Loco* loco)
+{
+	std::lock_guard<std::mutex> guard(mutex);
+	ramps.erase(loco);
+	for (auto& ramp : ramps)
+	{
+		vector<Loco*>& slaves = ramp.second.slaves;
+		slaves.erase(std::remove(slaves.begin(), slaves.end(), loco), slaves.end());
+	}
+}
+
+void SpeedRamp::Worker()
+{
+	Utils::Utils::SetThreadName("SpeedRamp");
+	const std::chrono::milliseconds tickTime(static_cast<unsigned int>(TickTime));
+	std::unique_lock<std::mutex> lock(mutex);
+	steady_clock::time_point nextTick = steady_clock::now();
+	vector<Step> steps;
+	while (run)
+	{
+		if (ramps.empty())
+		{
+			condition.wait(lock);
+			nextTick = steady_clock::now() + tickTime;
+			continue;
+		}
+		if (condition.wait_until(lock, nextTick) == std::cv_status::no_timeout)
+		{
+			continue;
+		}
+		nextTick += tickTime;
+
+		steps.clear();
+		Tick(steps);
+		if (steps.size() == 0)
+		{
+			continue;
+		}
+		// the lock is held, so no loco can be removed while its speed is set
+		manager->LocoSpeedRampStep(steps);
+	}
+}
+
+void SpeedRamp::Tick(vector<Step>& steps)
+{
+	const steady_clock::time_point now = steady_clock::now();
+	for (auto rampIterator = ramps.begin(); rampIterator != ramps.end();)
+	{
+		Ramp& ramp = rampIterator->second;
+		const uint64_t elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - ramp.startTime).count();
+		const uint64_t delta = elapsed * MaxSpeed / ramp.rampTime;
+		Speed speed;
+		if (ramp.target > ramp.start)
+		{
+			speed = ramp.start + delta >= ramp.target ? ramp.target : static_cast<Speed>(ramp.start + delta);
+		}
+		else
+		{
+			speed = ramp.start <= ramp.target + delta ? ramp.target : static_cast<Speed>(ramp.start - delta);
+		}
+
+		if (speed != ramp.current)
+		{
+			ramp.current = speed;
+			steps.push_back({ ramp.controlType, rampIterator->first, speed });
+			for (auto slave : ramp.slaves)
+			{
+				steps.push_back({ ControlTypeInternal, slave, speed });
+			}
+		}
+
+		if (speed == ramp.target)
+		{
+			rampIterator = ramps.erase(rampIterator);
+			continue;
+		}
+		++rampIterator;
+	}
+}
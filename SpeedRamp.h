@@ -0,0 +1,100 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "DataTypes.h"
+
+class Manager;
+
+namespace DataModel
+{
+	class Loco;
+}
+
+// Simulates the inertia of the trains. A speed change of a loco with an acceleration or
+// deceleration time is not sent at once, the speed is interpolated on a fixed tick
+// instead. All speed steps of one tick are handed over to the manager together, so
+// every control gets one command per tick instead of one per loco.
+class SpeedRamp
+{
+	public:
+		struct Step
+		{
+			ControlType controlType;
+			DataModel::Loco* loco;
+			Speed speed;
+		};
+
+		SpeedRamp() = delete;
+		SpeedRamp(Manager* manager);
+		~SpeedRamp();
+
+		// returns false if the speed has to be set directly because the loco has no ramp
+		bool SetTarget(const ControlType controlType,
+			DataModel::Loco* loco,
+			const std::vector<DataModel::Loco*>& slaves,
+			const Speed target);
+
+		// stops ramping the loco, its speed stays as it is
+		void Cancel(DataModel::Loco* loco);
+
+		// returns true if the speed reported by the hardware is only the echo of a step
+		// sent by the ramp, otherwise the hardware has taken over and the ramp is cancelled
+		bool IsEchoOrCancel(DataModel::Loco* loco, const Speed speed);
+
+		// forgets the loco, also as slave of another loco
+		void Remove(DataModel::Loco* loco);
+
+	private:
+		struct Ramp
+		{
+			ControlType controlType;
+			std::vector<DataModel::Loco*> slaves;
+			Speed start;
+			Speed target;
+			Speed current;
+			Speed tolerance;
+			std::chrono::steady_clock::time_point startTime;
+			unsigned int rampTime;
+		};
+
+		void Worker();
+		void Tick(std::vector<Step>& steps);
+
+		// the speed a command station reports back is rounded to the speed steps of the protocol
+		static Speed RoundingTolerance(const Protocol protocol);
+
+		static const unsigned int TickTime = 100; // milliseconds
+
+		Manager* manager;
+		std::map<DataModel::Loco*,Ramp> ramps;
+		std::mutex mutex;
+		std::condition_variable condition;
+		volatile bool run;
+		std::thread worker;
+};
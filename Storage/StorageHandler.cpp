@@ -152,7 +152,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllLocos(map<LocoID,DataModel::Loco*>& locos)
+	void StorageHandler::AllLocos(Utils::ObjectMap<LocoID,DataModel::Loco*>& locos)
 	{
 		if (instance == nullptr)
 		{
@@ -182,7 +182,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllAccessories(std::map<AccessoryID,DataModel::Accessory*>& accessories)
+	void StorageHandler::AllAccessories(Utils::ObjectMap<AccessoryID,DataModel::Accessory*>& accessories)
 	{
 		if (instance == nullptr)
 		{
@@ -212,7 +212,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllFeedbacks(std::map<FeedbackID,DataModel::Feedback*>& feedbacks)
+	void StorageHandler::AllFeedbacks(Utils::ObjectMap<FeedbackID,DataModel::Feedback*>& feedbacks)
 	{
 		if (instance == nullptr)
 		{
@@ -242,7 +242,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllTracks(std::map<TrackID,DataModel::Track*>& tracks)
+	void StorageHandler::AllTracks(Utils::ObjectMap<TrackID,DataModel::Track*>& tracks)
 	{
 		if (instance == nullptr)
 		{
@@ -273,7 +273,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllSwitches(std::map<SwitchID,DataModel::Switch*>& switches)
+	void StorageHandler::AllSwitches(Utils::ObjectMap<SwitchID,DataModel::Switch*>& switches)
 	{
 		if (instance == nullptr)
 		{
@@ -352,7 +352,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllRoutes(std::map<RouteID,DataModel::Route*>& routes)
+	void StorageHandler::AllRoutes(Utils::ObjectMap<RouteID,DataModel::Route*>& routes)
 	{
 		if (instance == nullptr)
 		{
@@ -386,7 +386,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllLayers(std::map<LayerID,DataModel::Layer*>& layers)
+	void StorageHandler::AllLayers(Utils::ObjectMap<LayerID,DataModel::Layer*>& layers)
 	{
 		if (instance == nullptr)
 		{
@@ -415,7 +415,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllSignals(std::map<SignalID,DataModel::Signal*>& signals)
+	void StorageHandler::AllSignals(Utils::ObjectMap<SignalID,DataModel::Signal*>& signals)
 	{
 		if (instance == nullptr)
 		{
@@ -446,7 +446,7 @@ namespace Storage
 		CommitTransactionInternal();
 	}
 
-	void StorageHandler::AllClusters(std::map<ClusterID,DataModel::Cluster*>& clusters)
+	void StorageHandler::AllClusters(Utils::ObjectMap<ClusterID,DataModel::Cluster*>& clusters)
 	{
 		if (instance == nullptr)
 		{
@@ -28,6 +28,7 @@ along with RailControl; see the file LICENCE. If not see
 #include "Hardware/HardwareParams.h"
 #include "Storage/StorageInterface.h"
 #include "Storage/StorageParams.h"
+#include "Utils/ObjectMap.h"
 
 namespace Storage
 {
@@ -42,23 +43,23 @@ namespace Storage
 			~StorageHandler();
 			void AllHardwareParams(std::map<ControlID,Hardware::HardwareParams*>& hardwareParams);
 			void DeleteHardwareParams(const ControlID controlID);
-			void AllLocos(std::map<LocoID,DataModel::Loco*>& locos);
+			void AllLocos(Utils::ObjectMap<LocoID,DataModel::Loco*>& locos);
 			void DeleteLoco(LocoID locoID);
-			void AllAccessories(std::map<AccessoryID,DataModel::Accessory*>& accessories);
+			void AllAccessories(Utils::ObjectMap<AccessoryID,DataModel::Accessory*>& accessories);
 			void DeleteAccessory(AccessoryID accessoryID);
-			void AllFeedbacks(std::map<FeedbackID,DataModel::Feedback*>& feedbacks);
+			void AllFeedbacks(Utils::ObjectMap<FeedbackID,DataModel::Feedback*>& feedbacks);
 			void DeleteFeedback(FeedbackID feedbackID);
-			void AllTracks(std::map<TrackID,DataModel::Track*>& tracks);
+			void AllTracks(Utils::ObjectMap<TrackID,DataModel::Track*>& tracks);
 			void DeleteTrack(TrackID trackID);
-			void AllSwitches(std::map<SwitchID,DataModel::Switch*>& switches);
+			void AllSwitches(Utils::ObjectMap<SwitchID,DataModel::Switch*>& switches);
 			void DeleteSwitch(SwitchID switchID);
-			void AllRoutes(std::map<RouteID,DataModel::Route*>& routes);
+			void AllRoutes(Utils::ObjectMap<RouteID,DataModel::Route*>& routes);
 			void DeleteRoute(RouteID routeID);
-			void AllLayers(std::map<LayerID,DataModel::Layer*>& layers);
+			void AllLayers(Utils::ObjectMap<LayerID,DataModel::Layer*>& layers);
 			void DeleteLayer(LayerID layerID);
-			void AllSignals(std::map<SignalID,DataModel::Signal*>& signals);
+			void AllSignals(Utils::ObjectMap<SignalID,DataModel::Signal*>& signals);
 			void DeleteSignal(SignalID signalID);
-			void AllClusters(std::map<ClusterID,DataModel::Cluster*>& clusters);
+			void AllClusters(Utils::ObjectMap<ClusterID,DataModel::Cluster*>& clusters);
 			void DeleteCluster(ClusterID clusterID);
 			void Save(const Hardware::HardwareParams& hardwareParams);
 			void Save(const DataModel::Route& route);
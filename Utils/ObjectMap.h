@@ -0,0 +1,203 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Utils
+{
+	// Map from object ID to object as used for the registries of the manager. The entries are
+	// stored densely in a vector sorted by ID, so iterating touches contiguous memory in the same
+	// order as a std::map. Lookups go through a slot vector indexed by the ID itself. The IDs are
+	// the persistent small numbers handed out by the manager, so the slot vector stays compact.
+	// Inserting or erasing in the middle moves the following entries, which is fine as objects
+	// are created and deleted rarely compared to how often they are looked up.
+	template<class ID, class T>
+	class ObjectMap
+	{
+		public:
+			typedef std::pair<ID,T> value_type;
+			typedef typename std::vector<value_type>::iterator iterator;
+			typedef typename std::vector<value_type>::const_iterator const_iterator;
+
+			ObjectMap()
+			:	slots(),
+				entries()
+			{}
+
+			inline size_t size() const
+			{
+				return entries.size();
+			}
+
+			inline bool empty() const
+			{
+				return entries.empty();
+			}
+
+			inline iterator begin()
+			{
+				return entries.begin();
+			}
+
+			inline iterator end()
+			{
+				return entries.end();
+			}
+
+			inline const_iterator begin() const
+			{
+				return entries.begin();
+			}
+
+			inline const_iterator end() const
+			{
+				return entries.end();
+			}
+
+			inline size_t count(const ID id) const
+			{
+				return Index(id) == NoIndex ? 0 : 1;
+			}
+
+			iterator find(const ID id)
+			{
+				const uint32_t index = Index(id);
+				return index == NoIndex ? entries.end() : entries.begin() + index;
+			}
+
+			const_iterator find(const ID id) const
+			{
+				const uint32_t index = Index(id);
+				return index == NoIndex ? entries.end() : entries.begin() + index;
+			}
+
+			T& at(const ID id)
+			{
+				const uint32_t index = Index(id);
+				if (index == NoIndex)
+				{
+					throw std::out_of_range("ObjectMap::at");
+				}
+				return entries[index].second;
+			}
+
+			const T& at(const ID id) const
+			{
+				const uint32_t index = Index(id);
+				if (index == NoIndex)
+				{
+					throw std::out_of_range("ObjectMap::at");
+				}
+				return entries[index].second;
+			}
+
+			// returns the highest ID in use or 0 if the map is empty
+			inline ID MaxID() const
+			{
+				return entries.empty() ? 0 : entries.back().first;
+			}
+
+			T& operator[](const ID id)
+			{
+				const uint32_t index = Index(id);
+				if (index != NoIndex)
+				{
+					return entries[index].second;
+				}
+
+				const size_t slot = Slot(id);
+				if (slot >= slots.size())
+				{
+					slots.resize(slot + 1, NoIndex);
+				}
+
+				// new IDs are usually the highest ones, so this is an append in most cases
+				size_t position = entries.size();
+				while (position > 0 && entries[position - 1].first > id)
+				{
+					--position;
+				}
+				entries.insert(entries.begin() + position, value_type(id, T()));
+				Reindex(position);
+				return entries[position].second;
+			}
+
+			size_t erase(const ID id)
+			{
+				const uint32_t index = Index(id);
+				if (index == NoIndex)
+				{
+					return 0;
+				}
+				erase(entries.begin() + index);
+				return 1;
+			}
+
+			iterator erase(iterator position)
+			{
+				const size_t index = position - entries.begin();
+				slots[Slot(position->first)] = NoIndex;
+				iterator next = entries.erase(position);
+				Reindex(index);
+				return next;
+			}
+
+			void clear()
+			{
+				slots.clear();
+				entries.clear();
+			}
+
+		private:
+			static const uint32_t NoIndex = 0xFFFFFFFF;
+
+			static inline size_t Slot(const ID id)
+			{
+				// negative IDs become huge and are never found
+				return static_cast<typename std::make_unsigned<ID>::type>(id);
+			}
+
+			inline uint32_t Index(const ID id) const
+			{
+				const size_t slot = Slot(id);
+				return slot < slots.size() ? slots[slot] : static_cast<uint32_t>(NoIndex);
+			}
+
+			void Reindex(const size_t from)
+			{
+				for (size_t index = from; index < entries.size(); ++index)
+				{
+					slots[Slot(entries[index].first)] = static_cast<uint32_t>(index);
+				}
+			}
+
+			std::vector<uint32_t> slots;
+			std::vector<value_type> entries;
+	};
+
+	template<class ID, class T>
+	const uint32_t ObjectMap<ID,T>::NoIndex;
+}
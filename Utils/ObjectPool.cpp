@@ -0,0 +1,84 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include <new>
+
+#include "Utils/ObjectPool.h"
+
+namespace Utils
+{
+	BlockPool::BlockPool(const size_t blockSize, const size_t blocksPerChunk)
+	:	blockSize(BlockSize(blockSize)),
+		blocksPerChunk(blocksPerChunk == 0 ? 1 : blocksPerChunk),
+		blocksUsedInChunk(0),
+		freeBlocks(nullptr)
+	{
+	}
+
+	BlockPool::~BlockPool()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		for (char* chunk : chunks)
+		{
+			::operator delete(chunk);
+		}
+		chunks.clear();
+		freeBlocks = nullptr;
+	}
+
+	size_t BlockPool::BlockSize(const size_t size)
+	{
+		// every block must be able to hold the free list pointer and keep the alignment of operator new
+		const size_t alignment = alignof(std::max_align_t);
+		const size_t minimumSize = size < sizeof(FreeBlock) ? sizeof(FreeBlock) : size;
+		return (minimumSize + alignment - 1) / alignment * alignment;
+	}
+
+	void* BlockPool::Allocate()
+	{
+		std::lock_guard<std::mutex> guard(mutex);
+		if (freeBlocks != nullptr)
+		{
+			FreeBlock* block = freeBlocks;
+			freeBlocks = block->next;
+			return block;
+		}
+		if (chunks.empty() || blocksUsedInChunk == blocksPerChunk)
+		{
+			chunks.push_back(static_cast<char*>(::operator new(blockSize * blocksPerChunk)));
+			blocksUsedInChunk = 0;
+		}
+		void* block = chunks.back() + (blockSize * blocksUsedInChunk);
+		++blocksUsedInChunk;
+		return block;
+	}
+
+	void BlockPool::Free(void* block)
+	{
+		if (block == nullptr)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> guard(mutex);
+		FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+		freeBlock->next = freeBlocks;
+		freeBlocks = freeBlock;
+	}
+}
@@ -0,0 +1,110 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace Utils
+{
+	// Hands out blocks of one size carved from large chunks. Freed blocks are kept in a free list
+	// and reused, the chunks themselves are only given back to the system at once when the pool
+	// is destroyed. The pool is thread safe.
+	class BlockPool
+	{
+		public:
+			BlockPool(const size_t blockSize, const size_t blocksPerChunk);
+			~BlockPool();
+
+			BlockPool(const BlockPool&) = delete;
+			BlockPool& operator=(const BlockPool&) = delete;
+
+			void* Allocate();
+			void Free(void* block);
+
+			inline size_t GetChunkCount() const
+			{
+				std::lock_guard<std::mutex> guard(mutex);
+				return chunks.size();
+			}
+
+		private:
+			struct FreeBlock
+			{
+				FreeBlock* next;
+			};
+
+			static size_t BlockSize(const size_t size);
+
+			mutable std::mutex mutex;
+			const size_t blockSize;
+			const size_t blocksPerChunk;
+			std::vector<char*> chunks;
+			size_t blocksUsedInChunk;
+			FreeBlock* freeBlocks;
+	};
+
+	// Deriving from PoolAllocated<T> makes new and delete of T use a BlockPool shared by all
+	// objects of type T. Layouts consist of thousands of small objects of a few types, keeping
+	// them together saves the per allocation overhead of the heap and keeps them close in memory.
+	// Objects of other sizes than T, e.g. of derived classes, are allocated from the heap.
+	template<class T>
+	class PoolAllocated
+	{
+		public:
+			static void* operator new(size_t size)
+			{
+				if (size != sizeof(T))
+				{
+					return ::operator new(size);
+				}
+				return Pool().Allocate();
+			}
+
+			static void operator delete(void* pointer, size_t size)
+			{
+				if (pointer == nullptr)
+				{
+					return;
+				}
+				if (size != sizeof(T))
+				{
+					::operator delete(pointer);
+					return;
+				}
+				Pool().Free(pointer);
+			}
+
+		protected:
+			PoolAllocated() {}
+			~PoolAllocated() {}
+
+		private:
+			static const size_t BlocksPerChunk = 256;
+
+			static BlockPool& Pool()
+			{
+				static BlockPool pool(sizeof(T), static_cast<size_t>(BlocksPerChunk));
+				return pool;
+			}
+	};
+}
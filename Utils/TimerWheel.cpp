@@ -0,0 +1,103 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#include "Utils/TimerWheel.h"
+
+namespace Utils
+{
+	TimerWheel::TimerWheel()
+	:	current(0),
+		size(0)
+	{
+	}
+
+	void TimerWheel::Add(const TimerID timerID, const Tick deadline)
+	{
+		Entry entry;
+		entry.timerID = timerID;
+		entry.deadline = deadline;
+		const int32_t delta = static_cast<int32_t>(deadline - current);
+		if (delta <= 0)
+		{
+			// a timer in the past expires with the next tick
+			entry.deadline = current + 1;
+		}
+		else if (static_cast<Tick>(delta) > MaxDelta)
+		{
+			entry.deadline = current + MaxDelta;
+		}
+		Insert(entry);
+		++size;
+	}
+
+	void TimerWheel::Insert(const Entry& entry)
+	{
+		const Tick delta = entry.deadline - current;
+		unsigned char level = 0;
+		while (level < Levels - 1 && delta >= (static_cast<Tick>(1) << (SlotBits * (level + 1))))
+		{
+			++level;
+		}
+		slots[level][(entry.deadline >> (SlotBits * level)) & SlotMask].push_back(entry);
+	}
+
+	void TimerWheel::Cascade(const unsigned char level)
+	{
+		std::vector<Entry> entries;
+		entries.swap(slots[level][(current >> (SlotBits * level)) & SlotMask]);
+		for (auto entry : entries)
+		{
+			Insert(entry);
+		}
+	}
+
+	void TimerWheel::Advance(const Tick now, std::vector<TimerID>& expired)
+	{
+		while (static_cast<int32_t>(now - current) > 0)
+		{
+			++current;
+			if ((current & ((static_cast<Tick>(1) << (SlotBits * 2)) - 1)) == 0)
+			{
+				Cascade(2);
+			}
+			if ((current & SlotMask) == 0)
+			{
+				Cascade(1);
+			}
+
+			std::vector<Entry>& slot = slots[0][current & SlotMask];
+			for (auto entry : slot)
+			{
+				expired.push_back(entry.timerID);
+			}
+			size -= slot.size();
+			slot.clear();
+		}
+	}
+
+	void TimerWheel::SetCurrentTick(const Tick now)
+	{
+		if (size != 0)
+		{
+			return;
+		}
+		current = now;
+	}
+} // namespace Utils
@@ -0,0 +1,83 @@
+/*
+RailControl - Model Railway Control Software
+
+Copyright (c) 2017-2020 Dominik (Teddy) Mahrer - www.railcontrol.org
+
+RailControl is free software; you can redistribute it and/or modify it
+under the terms of the GNU General Public License as published by the
+Free Software Foundation; either version 3, or (at your option) any
+later version.
+
+RailControl is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with RailControl; see the file LICENCE. If not see
+<http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Utils
+{
+	// Hierarchical timer wheel. Time is counted in ticks, the length of a tick is defined by the user.
+	// Adding and expiring a timer is O(1), a timer is only moved when its level gets cascaded.
+	// The wheel is not thread safe.
+	class TimerWheel
+	{
+		public:
+			typedef uint32_t Tick;
+			typedef uint32_t TimerID;
+
+			TimerWheel();
+
+			void Add(const TimerID timerID, const Tick deadline);
+
+			// advances the wheel up to now and appends all expired timers to expired
+			void Advance(const Tick now, std::vector<TimerID>& expired);
+
+			// only allowed when the wheel is empty
+			void SetCurrentTick(const Tick now);
+
+			inline Tick GetCurrentTick() const
+			{
+				return current;
+			}
+
+			inline bool IsEmpty() const
+			{
+				return size == 0;
+			}
+
+			inline size_t GetSize() const
+			{
+				return size;
+			}
+
+		private:
+			struct Entry
+			{
+				TimerID timerID;
+				Tick deadline;
+			};
+
+			void Insert(const Entry& entry);
+			void Cascade(const unsigned char level);
+
+			static const unsigned char SlotBits = 6;
+			static const Tick SlotsPerLevel = 1 << SlotBits;
+			static const Tick SlotMask = SlotsPerLevel - 1;
+			static const unsigned char Levels = 3;
+			static const Tick MaxDelta = (1 << (SlotBits * Levels)) - 1;
+
+			std::vector<Entry> slots[Levels][SlotsPerLevel];
+			Tick current;
+			size_t size;
+	};
+} // namespace Utils
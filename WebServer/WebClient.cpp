@@ -252,6 +252,14 @@ namespace WebServer
 			{
 				HandleLocoRelease(arguments);
 			}
+			else if (arguments["cmd"].compare("locoplan") == 0)
+			{
+				HandleLocoPlan(arguments);
+			}
+			else if (arguments["cmd"].compare("lococalibration") == 0)
+			{
+				HandleLocoCalibration(arguments);
+			}
 			else if (arguments["cmd"].compare("accessoryedit") == 0)
 			{
 				HandleAccessoryEdit(arguments);
@@ -1189,6 +1197,44 @@ namespace WebServer
 		ReplyHtmlWithHeaderAndParagraph(ret ? "Loco released" : "Loco not released");
 	}
 
+	void WebClient::HandleLocoPlan(const map<string, string>& arguments)
+	{
+		const LocoID locoID = Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone);
+		const ObjectIdentifier destination(Utils::Utils::GetStringMapEntry(arguments, "track"), Utils::Utils::GetStringMapEntry(arguments, "signal"));
+		const TrackBase* track = manager.GetTrackBase(destination);
+		const string trackName = (track == nullptr ? "" : track->GetMyName());
+		vector<Route*> path;
+		if (track == nullptr || manager.RoutePlan(locoID, destination, path) == false)
+		{
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextRoutePlanNotFound, manager.GetLocoName(locoID), trackName);
+			return;
+		}
+		string routeNames;
+		for (auto route : path)
+		{
+			if (routeNames.size() > 0)
+			{
+				routeNames += ", ";
+			}
+			routeNames += route->GetName();
+		}
+		ReplyHtmlWithHeaderAndParagraph(Languages::TextRoutePlan, manager.GetLocoName(locoID), trackName, routeNames);
+	}
+
+	void WebClient::HandleLocoCalibration(const map<string, string>& arguments)
+	{
+		// the same button starts and stops the calibration
+		if (manager.LocoCalibrationRunning())
+		{
+			manager.LocoCalibrationStop();
+			ReplyHtmlWithHeaderAndParagraph(Languages::TextCalibrationStopped, manager.GetLocoName(Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone)));
+			return;
+		}
+		string result;
+		manager.LocoCalibrationStart(Utils::Utils::GetIntegerMapEntry(arguments, "loco", LocoNone), result);
+		ReplyHtmlWithHeaderAndParagraph(result);
+	}
+
 	HtmlTag WebClient::HtmlTagProtocol(const map<string,Protocol>& protocolMap, const Protocol selectedProtocol)
 	{
 		HtmlTag content;
@@ -1617,8 +1663,10 @@ namespace WebServer
 	HtmlTag WebClient::HtmlTagNrOfTracksToReserve(const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve)
 	{
 		map<DataModel::Loco::NrOfTracksToReserve,string> options;
-		options[DataModel::Loco::ReserveOne] = "1";
-		options[DataModel::Loco::ReserveTwo] = "2";
+		for (int nr = DataModel::Loco::ReserveOne; nr <= DataModel::Loco::ReserveMax; ++nr)
+		{
+			options[static_cast<DataModel::Loco::NrOfTracksToReserve>(nr)] = to_string(nr);
+		}
 		return HtmlTagSelectWithLabel("nroftrackstoreserve", Languages::TextNrOfTracksToReserve, options, nrOfTracksToReserve);
 	}
 
@@ -1748,6 +1796,11 @@ namespace WebServer
 		Speed travelSpeed = DefaultTravelSpeed;
 		Speed reducedSpeed = DefaultReducedSpeed;
 		Speed creepingSpeed = DefaultCreepingSpeed;
+		unsigned int accelerationTime = 0;
+		unsigned int decelerationTime = 0;
+		FeedbackID calibrationFeedbackStart = FeedbackNone;
+		FeedbackID calibrationFeedbackEnd = FeedbackNone;
+		Length calibrationDistance = 0;
 		const LocoFunctionEntry* locoFunctions = nullptr;
 		vector<Relation*> slaves;
 
@@ -1766,6 +1819,11 @@ namespace WebServer
 				travelSpeed = loco->GetTravelSpeed();
 				reducedSpeed = loco->GetReducedSpeed();
 				creepingSpeed = loco->GetCreepingSpeed();
+				accelerationTime = loco->GetAccelerationTime();
+				decelerationTime = loco->GetDecelerationTime();
+				calibrationFeedbackStart = loco->GetCalibrationFeedbackStart();
+				calibrationFeedbackEnd = loco->GetCalibrationFeedbackEnd();
+				calibrationDistance = loco->GetCalibrationDistance();
 				locoFunctions = loco->GetFunctions();
 				slaves = loco->GetSlaves();
 			}
@@ -1776,6 +1834,7 @@ namespace WebServer
 		tabMenu.AddChildTag(HtmlTagTabMenuItem("basic", Languages::TextBasic, true));
 		tabMenu.AddChildTag(HtmlTagTabMenuItem("functions", Languages::TextFunctions));
 		tabMenu.AddChildTag(HtmlTagTabMenuItem("slaves", Languages::TextMultipleUnit));
+		tabMenu.AddChildTag(HtmlTagTabMenuItem("calibration", Languages::TextCalibration));
 		tabMenu.AddChildTag(HtmlTagTabMenuItem("automode", Languages::TextAutomode));
 		content.AddChildTag(tabMenu);
 
@@ -1957,8 +2016,25 @@ namespace WebServer
 		automodeContent.AddChildTag(HtmlTagInputIntegerWithLabel("travelspeed", Languages::TextTravelSpeed, travelSpeed, 0, MaxSpeed));
 		automodeContent.AddChildTag(HtmlTagInputIntegerWithLabel("reducedspeed", Languages::TextReducedSpeed, reducedSpeed, 0, MaxSpeed));
 		automodeContent.AddChildTag(HtmlTagInputIntegerWithLabel("creepingspeed", Languages::TextCreepingSpeed, creepingSpeed, 0, MaxSpeed));
+		automodeContent.AddChildTag(HtmlTagInputIntegerWithLabel("accelerationtime", Languages::TextAccelerationTime, accelerationTime, 0, MaxRampTime));
+		automodeContent.AddChildTag(HtmlTagInputIntegerWithLabel("decelerationtime", Languages::TextDecelerationTime, decelerationTime, 0, MaxRampTime));
 		formContent.AddChildTag(automodeContent);
 
+		HtmlTag calibrationContent("div");
+		calibrationContent.AddId("tab_calibration");
+		calibrationContent.AddClass("tab_content");
+		calibrationContent.AddClass("hidden");
+		map<string,FeedbackID> feedbackOptions;
+		feedbackOptions["-"] = FeedbackNone;
+		for (auto& feedback : manager.FeedbackListByName())
+		{
+			feedbackOptions[feedback.first] = feedback.second->GetID();
+		}
+		calibrationContent.AddChildTag(HtmlTagSelectWithLabel("calibrationstart", Languages::TextCalibrationStart, feedbackOptions, calibrationFeedbackStart));
+		calibrationContent.AddChildTag(HtmlTagSelectWithLabel("calibrationend", Languages::TextCalibrationEnd, feedbackOptions, calibrationFeedbackEnd));
+		calibrationContent.AddChildTag(HtmlTagInputIntegerWithLabel("calibrationdistance", Languages::TextCalibrationDistance, calibrationDistance, 0, 99999));
+		formContent.AddChildTag(calibrationContent);
+
 		content.AddChildTag(HtmlTag("div").AddClass("popup_content").AddChildTag(formContent));
 		content.AddChildTag(HtmlTagButtonCancel());
 		content.AddChildTag(HtmlTagButtonOK());
@@ -1990,6 +2066,11 @@ namespace WebServer
 		{
 			creepingSpeed = reducedSpeed;
 		}
+		const unsigned int accelerationTime = Utils::Utils::GetIntegerMapEntry(arguments, "accelerationtime", 0);
+		const unsigned int decelerationTime = Utils::Utils::GetIntegerMapEntry(arguments, "decelerationtime", 0);
+		const FeedbackID calibrationFeedbackStart = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationstart", FeedbackNone);
+		const FeedbackID calibrationFeedbackEnd = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationend", FeedbackNone);
+		const Length calibrationDistance = Utils::Utils::GetIntegerMapEntry(arguments, "calibrationdistance", 0);
 
 		vector<DataModel::LocoFunctionEntry> locoFunctions;
 		DataModel::LocoFunctionEntry locoFunctionEntry;
@@ -2043,6 +2124,11 @@ namespace WebServer
 			travelSpeed,
 			reducedSpeed,
 			creepingSpeed,
+			accelerationTime,
+			decelerationTime,
+			calibrationFeedbackStart,
+			calibrationFeedbackEnd,
+			calibrationDistance,
 			locoFunctions,
 			slaves,
 			result))
@@ -2146,7 +2232,7 @@ namespace WebServer
 
 		if (layer < LayerUndeletable)
 		{
-			const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
+			const Utils::ObjectMap<FeedbackID,Feedback*> feedbacks = manager.FeedbackList();
 			for (auto feedback : feedbacks)
 			{
 				if (feedback.second->GetControlID() != -layer)
@@ -2160,64 +2246,39 @@ namespace WebServer
 			return;
 		}
 
-		const map<AccessoryID,DataModel::Accessory*>& accessories = manager.AccessoryList();
-		for (auto accessory : accessories)
+		vector<LayoutGrid::Item> items;
+		manager.LayoutItemsOnLayer(layer, items);
+		for (auto item : items)
 		{
-			if (accessory.second->IsVisibleOnLayer(layer) == false)
+			switch (item.first)
 			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagAccessory(accessory.second));
-		}
+				case ObjectTypeAccessory:
+					content.AddChildTag(HtmlTagAccessory(dynamic_cast<DataModel::Accessory*>(item.second)));
+					break;
 
-		const map<SwitchID,DataModel::Switch*>& switches = manager.SwitchList();
-		for (auto mySwitch : switches)
-		{
-			if (mySwitch.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagSwitch(mySwitch.second));
-		}
+				case ObjectTypeSwitch:
+					content.AddChildTag(HtmlTagSwitch(dynamic_cast<DataModel::Switch*>(item.second)));
+					break;
 
-		const map<SwitchID,DataModel::Track*>& tracks = manager.TrackList();
-		for (auto track : tracks)
-		{
-			if (track.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagTrack(manager, track.second));
-		}
+				case ObjectTypeTrack:
+					content.AddChildTag(HtmlTagTrack(manager, dynamic_cast<DataModel::Track*>(item.second)));
+					break;
 
-		const map<RouteID,DataModel::Route*>& routes = manager.RouteList();
-		for (auto route : routes)
-		{
-			if (route.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagRoute(route.second));
-		}
+				case ObjectTypeRoute:
+					content.AddChildTag(HtmlTagRoute(dynamic_cast<DataModel::Route*>(item.second)));
+					break;
 
-		const map<FeedbackID,Feedback*>& feedbacks = manager.FeedbackList();
-		for (auto feedback : feedbacks)
-		{
-			if (feedback.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
-			}
-			content.AddChildTag(HtmlTagFeedback(feedback.second));
-		}
+				case ObjectTypeFeedback:
+					content.AddChildTag(HtmlTagFeedback(dynamic_cast<DataModel::Feedback*>(item.second)));
+					break;
 
-		const map<SignalID,DataModel::Signal*>& signals = manager.SignalList();
-		for (auto signal : signals)
-		{
-			if (signal.second->IsVisibleOnLayer(layer) == false)
-			{
-				continue;
+				case ObjectTypeSignal:
+					content.AddChildTag(HtmlTagSignal(manager, dynamic_cast<DataModel::Signal*>(item.second)));
+					break;
+
+				default:
+					break;
 			}
-			content.AddChildTag(HtmlTagSignal(manager, signal.second));
 		}
 
 		ReplyHtmlWithHeader(content);
@@ -3331,6 +3392,7 @@ namespace WebServer
 		const DataModel::AccessoryPulseDuration defaultAccessoryDuration = manager.GetDefaultAccessoryDuration();
 		const bool autoAddFeedback = manager.GetAutoAddFeedback();
 		const bool stopOnFeedbackInFreeTrack = manager.GetStopOnFeedbackInFreeTrack();
+		const bool executeRoutesInBatches = manager.GetExecuteRoutesInBatches();
 		const DataModel::SelectRouteApproach selectRouteApproach = manager.GetSelectRouteApproach();
 		const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve = manager.GetNrOfTracksToReserve();
 
@@ -3344,6 +3406,7 @@ namespace WebServer
 		formContent.AddChildTag(HtmlTagDuration(defaultAccessoryDuration, Languages::TextDefaultSwitchingDuration));
 		formContent.AddChildTag(HtmlTagInputCheckboxWithLabel("autoaddfeedback", Languages::TextAutomaticallyAddUnknownFeedbacks, "autoaddfeedback", autoAddFeedback));
 		formContent.AddChildTag(HtmlTagInputCheckboxWithLabel("stoponfeedbackinfreetrack", Languages::TextStopOnFeedbackInFreeTrack, "stoponfeedbackinfreetrack", stopOnFeedbackInFreeTrack));
+		formContent.AddChildTag(HtmlTagInputCheckboxWithLabel("executeroutesinbatches", Languages::TextExecuteRoutesInBatches, "executeroutesinbatches", executeRoutesInBatches));
 		formContent.AddChildTag(HtmlTagSelectSelectRouteApproach(selectRouteApproach, false));
 		formContent.AddChildTag(HtmlTagNrOfTracksToReserve(nrOfTracksToReserve));
 		formContent.AddChildTag(HtmlTagLogLevel());
@@ -3360,10 +3423,11 @@ namespace WebServer
 		const DataModel::AccessoryPulseDuration defaultAccessoryDuration = Utils::Utils::GetIntegerMapEntry(arguments, "duration", manager.GetDefaultAccessoryDuration());
 		const bool autoAddFeedback = Utils::Utils::GetBoolMapEntry(arguments, "autoaddfeedback", manager.GetAutoAddFeedback());
 		const bool stopOnFeedbackInFreeTrack = Utils::Utils::GetBoolMapEntry(arguments, "stoponfeedbackinfreetrack", manager.GetStopOnFeedbackInFreeTrack());
+		const bool executeRoutesInBatches = Utils::Utils::GetBoolMapEntry(arguments, "executeroutesinbatches", manager.GetExecuteRoutesInBatches());
 		const DataModel::SelectRouteApproach selectRouteApproach = static_cast<DataModel::SelectRouteApproach>(Utils::Utils::GetIntegerMapEntry(arguments, "selectrouteapproach", DataModel::SelectRouteRandom));
 		const DataModel::Loco::NrOfTracksToReserve nrOfTracksToReserve = static_cast<DataModel::Loco::NrOfTracksToReserve>(Utils::Utils::GetIntegerMapEntry(arguments, "nroftrackstoreserve", DataModel::Loco::ReserveOne));
 		const Logger::Logger::Level logLevel = static_cast<Logger::Logger::Level>(Utils::Utils::GetIntegerMapEntry(arguments, "loglevel", Logger::Logger::LevelInfo));
-		manager.SaveSettings(language, defaultAccessoryDuration, autoAddFeedback, stopOnFeedbackInFreeTrack, selectRouteApproach, nrOfTracksToReserve, logLevel);
+		manager.SaveSettings(language, defaultAccessoryDuration, autoAddFeedback, stopOnFeedbackInFreeTrack, executeRoutesInBatches, selectRouteApproach, nrOfTracksToReserve, logLevel);
 		ReplyResponse(ResponseInfo, Languages::TextSettingsSaved);
 	}
 
@@ -3725,7 +3789,7 @@ namespace WebServer
 
 	HtmlTag WebClient::HtmlTagLocoSelector() const
 	{
-		const map<LocoID, Loco*>& locos = manager.locoList();
+		const Utils::ObjectMap<LocoID,Loco*> locos = manager.locoList();
 		map<string,LocoID> options;
 		for (auto locoTMP : locos)
 		{
@@ -3770,6 +3834,9 @@ namespace WebServer
 		id = "locoedit_" + to_string(locoID);
 		container.AddChildTag(HtmlTagButtonPopup("<svg width=\"36\" height=\"36\"><circle r=\"7\" cx=\"14\" cy=\"14\" fill=\"black\" /><line x1=\"14\" y1=\"5\" x2=\"14\" y2=\"23\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"9.5\" y1=\"6.2\" x2=\"18.5\" y2=\"21.8\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"6.2\" y1=\"9.5\" x2=\"21.8\" y2=\"18.5\" stroke-width=\"2\" stroke=\"black\" /><line y1=\"14\" x1=\"5\" y2=\"14\" x2=\"23\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"9.5\" y1=\"21.8\" x2=\"18.5\" y2=\"6.2\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"6.2\" y1=\"18.5\" x2=\"21.8\" y2=\"9.5\" stroke-width=\"2\" stroke=\"black\" /><circle r=\"5\" cx=\"14\" cy=\"14\" fill=\"lightgray\" /><circle r=\"4\" cx=\"24\" cy=\"24\" fill=\"black\" /><line x1=\"18\" y1=\"24\" x2=\"30\" y2=\"24\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"28.2\" y1=\"28.2\" x2=\"19.8\" y2=\"19.8\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"24\" y1=\"18\" x2=\"24\" y2=\"30\" stroke-width=\"2\" stroke=\"black\" /><line x1=\"19.8\" y1=\"28.2\" x2=\"28.2\" y2=\"19.8\" stroke-width=\"2\" stroke=\"black\" /><circle r=\"2\" cx=\"24\" cy=\"24\" fill=\"lightgray\" /></svg>", id, buttonArguments));
 
+		id = "lococalibration_" + to_string(locoID);
+		container.AddChildTag(HtmlTagButtonCommand("CAL", id, buttonArguments, Languages::GetText(Languages::TextCalibration)));
+
 		id = "locoorientation_" + to_string(locoID);
 		container.AddChildTag(HtmlTagButtonCommandToggle("<svg width=\"36\" height=\"36\">"
 			"<polyline points=\"5,15 31,15 31,23 5,23\" stroke=\"black\" stroke-width=\"0\" fill=\"black\" />"
@@ -253,6 +253,8 @@ namespace WebServer
 			void HandleLocoAskDelete(const std::map<std::string, std::string>& arguments);
 			void HandleLocoDelete(const std::map<std::string, std::string>& arguments);
 			void HandleLocoRelease(const std::map<std::string, std::string>& arguments);
+			void HandleLocoPlan(const std::map<std::string, std::string>& arguments);
+			void HandleLocoCalibration(const std::map<std::string, std::string>& arguments);
 			void HandleProtocol(const std::map<std::string, std::string>& arguments);
 			void HandleLayout(const std::map<std::string,std::string>& arguments);
 			void HandleAccessoryEdit(const std::map<std::string,std::string>& arguments);